@@ -0,0 +1,137 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/*
+ * Compares the hex codec of utils.h with the char by char implementation it replaced.
+ *
+ * Build and run:
+ *
+ *     g++ -std=c++17 -O2 -I../../src hex_benchmark.cpp -o hex_benchmark && ./hex_benchmark
+ */
+
+#include "utils.h"
+
+#include <chrono>
+#include <random>
+
+namespace
+{
+    // The previous implementation, kept as the baseline
+    iolink::vector_t referenceDecode(const iolink::string_t &str)
+    {
+        auto hexCharToInt = [](const char ch) -> uint8_t
+        {
+            static const char* const lut_upper = "0123456789ABCDEF";
+            static const char* const lut_lower = "0123456789abcdef";
+
+            const char* p = std::lower_bound(lut_lower, lut_lower + 16, ch);
+            if (*p == ch)
+                return uint8_t(p - lut_lower);
+
+            p = std::lower_bound(lut_upper, lut_upper + 16, ch);
+            if(*p == ch)
+                return uint8_t(p - lut_upper);
+
+            throw iolink::utils::exception_argument(__func__, "Input string contains a char that is not a hex digit");
+        };
+
+        iolink::vector_t output;
+        output.reserve(str.length() / 2);
+
+        for (size_t i = 0; i < str.length(); i += 2)
+            output.push_back((hexCharToInt(str[i]) << 4) | hexCharToInt(str[i + 1]));
+
+        return output;
+    }
+
+    iolink::string_t referenceEncode(const iolink::vector_t &data)
+    {
+        static const char* const lut_upper = "0123456789ABCDEF";
+        iolink::string_t output;
+
+        output.reserve(2 * data.size());
+
+        for(const uint8_t c: data)
+        {
+            output.push_back(lut_upper[c >> 4]);
+            output.push_back(lut_upper[c & 0x0F]);
+        }
+
+        return output;
+    }
+
+    template<typename Function>
+    double measure(size_t iterations, size_t bytes, Function &&function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for(size_t i = 0; i < iterations; ++i)
+            function();
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        // MB/s of decoded data
+        return static_cast<double>(iterations * bytes) / elapsed.count() / 1e6;
+    }
+
+    void run(size_t bytes, size_t iterations)
+    {
+        std::mt19937 generator{42};
+        iolink::vector_t data(bytes);
+
+        for(auto &byte: data)
+            byte = static_cast<uint8_t>(generator());
+
+        const auto hex = referenceEncode(data);
+        iolink::vector_t decoded(bytes);
+        iolink::string_t encoded(2 * bytes, '0');
+        volatile size_t sink = 0;
+
+        if(!iolink::utils::hexDecode(hex.data(), hex.size(), decoded.data()) || decoded != data)
+            throw std::logic_error("Decoded data differs");
+
+        iolink::utils::hexEncode(data.data(), data.size(), encoded.data());
+        if(encoded != hex)
+            throw std::logic_error("Encoded data differs");
+
+        const double reference_decode = measure(iterations, bytes, [&]{sink = sink + referenceDecode(hex).size();});
+        const double string_decode    = measure(iterations, bytes, [&]{sink = sink + iolink::utils::hexDecode<iolink::vector_t>(hex).size();});
+        const double buffer_decode    = measure(iterations, bytes, [&]{sink = sink + iolink::utils::hexDecode(hex.data(), hex.size(), decoded.data());});
+        const double reference_encode = measure(iterations, bytes, [&]{sink = sink + referenceEncode(data).size();});
+        const double buffer_encode    = measure(iterations, bytes, [&]{iolink::utils::hexEncode(data.data(), data.size(), encoded.data()); sink = sink + encoded[0];});
+
+        std::cout << bytes << " bytes, MB/s\n"
+                  << "    decode  reference " << reference_decode << "  vector_t " << string_decode << "  buffer " << buffer_decode << "\n"
+                  << "    encode  reference " << reference_encode << "  buffer " << buffer_encode << std::endl;
+    }
+}
+
+int main()
+{
+#ifdef IOLINK_HEX_SSE2
+    std::cout << "SSE2 enabled" << std::endl;
+#endif
+
+    run(32, 2000000);           // Process data of a port
+    run(232, 500000);           // Largest acyclic parameter
+    run(4 * 1024 * 1024, 10);   // Firmware blob
+
+    return 0;
+}
@@ -0,0 +1,314 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+
+/*
+ * Runs HttpComm against a minimal HTTP server on the loopback interface, so the connection handling can be checked
+ * without a master.
+ *
+ * Build and run:
+ *
+ *     g++ -std=c++17 -O2 -I../../src loopback_test.cpp -o loopback_test -pthread && ./loopback_test
+ *
+ * The server answers every request with a small JSON body and keeps the connection open, except for the targets:
+ *
+ *     /slow   - never answers
+ *     /close  - answers and closes the connection afterwards, like a master dropping an idle connection
+ *     /reset  - closes the connection without answering
+ */
+
+#include "iot/httpcomm.h"
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace iolink;
+using namespace std::chrono_literals;
+using ErrorCodeType = iolink::utils::exception_comm::ErrorCodeType;
+
+class LoopbackServer
+{
+    public:
+        LoopbackServer()
+        {
+            m_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+
+            int enable = 1;
+            ::setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+            sockaddr_in address{};
+            address.sin_family      = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port        = 0;
+
+            socklen_t length = sizeof(address);
+            if(::bind(m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+               ::listen(m_fd, 16) != 0 ||
+               ::getsockname(m_fd, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+                throw std::runtime_error{"Can not start the loopback server"};
+
+            m_port   = ntohs(address.sin_port);
+            m_thread = std::thread{[this]{accept();}};
+        }
+
+        ~LoopbackServer()
+        {
+            m_stop = true;
+            m_thread.join();
+
+            for(auto &thread: m_connections)
+                thread.join();
+
+            ::close(m_fd);
+        }
+
+        uint16_t port() const
+        {
+            return m_port;
+        }
+
+        size_t accepted() const
+        {
+            return m_accepted;
+        }
+
+        // Number of received requests whose target or body contains the text
+        size_t received(const std::string &text) const
+        {
+            std::lock_guard lock{m_mutex};
+            return static_cast<size_t>(std::count_if(m_requests.begin(), m_requests.end(), [&text](const std::string &request){return request.find(text) != std::string::npos;}));
+        }
+
+    private:
+        void accept()
+        {
+            while(!m_stop)
+            {
+                pollfd fd{m_fd, POLLIN, 0};
+                if(::poll(&fd, 1, 20) <= 0)
+                    continue;
+
+                int connection = ::accept(m_fd, nullptr, nullptr);
+                if(connection < 0)
+                    continue;
+
+                ++m_accepted;
+                m_connections.emplace_back([this, connection]{serve(connection);});
+            }
+        }
+
+        void serve(int fd)
+        {
+            std::string buffer;
+
+            while(!m_stop)
+            {
+                auto end = buffer.find("\r\n\r\n");
+
+                if(end == std::string::npos)
+                {
+                    if(!receive(fd, buffer))
+                        break;
+
+                    continue;
+                }
+
+                size_t content_length = 0;
+                auto   header         = buffer.find("Content-Length: ");
+                if(header != std::string::npos && header < end)
+                    content_length = std::stoul(buffer.substr(header + 16));
+
+                if(buffer.size() < end + 4 + content_length)
+                {
+                    if(!receive(fd, buffer))
+                        break;
+
+                    continue;
+                }
+
+                auto request = buffer.substr(0, end + 4 + content_length);
+                buffer.erase(0, request.size());
+
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_requests.push_back(request);
+                }
+
+                auto target = request.substr(request.find(' ') + 1);
+                target = target.substr(0, target.find(' '));
+
+                if(target == "/reset")
+                    break;
+
+                if(target == "/slow")
+                {
+                    while(!m_stop && receive(fd, buffer));
+                    break;
+                }
+
+                std::string body = R"({"cid":-1,"code":200,"data":{"value":"OK"}})";
+                std::string response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) +
+                                       "\r\nConnection: keep-alive\r\n\r\n" + body;
+                ::send(fd, response.data(), response.size(), MSG_NOSIGNAL);
+
+                if(target == "/close")
+                    break;
+            }
+
+            ::close(fd);
+        }
+
+        bool receive(int fd, std::string &buffer)
+        {
+            pollfd event{fd, POLLIN, 0};
+            while(!m_stop && ::poll(&event, 1, 20) == 0);
+
+            char chunk[1024];
+            auto received = m_stop ? 0 : ::recv(fd, chunk, sizeof(chunk), 0);
+            if(received <= 0)
+                return false;
+
+            buffer.append(chunk, static_cast<size_t>(received));
+            return true;
+        }
+
+        int                      m_fd = -1;
+        uint16_t                 m_port = 0;
+        std::atomic<bool>        m_stop{false};
+        std::atomic<size_t>      m_accepted{0};
+        std::thread              m_thread;
+        std::vector<std::thread> m_connections;
+        mutable std::mutex       m_mutex;
+        std::vector<std::string> m_requests;
+};
+
+static int failures = 0;
+
+static void check(bool condition, const char *what)
+{
+    std::printf("%s %s\n", condition ? "PASS" : "FAIL", what);
+    failures += condition ? 0 : 1;
+}
+
+template<typename Function>
+static ErrorCodeType errorOf(Function &&function)
+{
+    try
+    {
+        function();
+    }
+    catch(const iolink::utils::exception_comm &e)
+    {
+        return e.error_code();
+    }
+
+    return ErrorCodeType::BAD_RESPONSE;
+}
+
+int main()
+{
+    // Keep-alive: consecutive requests share one connection
+    {
+        LoopbackServer server;
+        iot::HttpComm  comm{"127.0.0.1", server.port()};
+
+        bool answered = true;
+        for(int i = 0; i < 10; ++i)
+            answered = answered && comm.httpGet("/getdata").find("OK") != string_t::npos;
+
+        check(answered, "keep-alive: every request is answered");
+        check(server.accepted() == 1, "keep-alive: ten requests use one connection");
+        check(comm.idleConnections() == 1, "keep-alive: the connection returns to the pool");
+    }
+
+    // Timeout: a master that does not answer
+    {
+        LoopbackServer server;
+        iot::HttpComm  comm{"127.0.0.1", server.port(), iot::HttpTimeouts{100ms, 200ms}};
+
+        auto start = std::chrono::steady_clock::now();
+        auto error = errorOf([&comm]{comm.httpGet("/slow");});
+        auto took  = std::chrono::steady_clock::now() - start;
+
+        check(error == ErrorCodeType::ERROR_TIMEOUT, "timeout: blocking request times out");
+        check(took < 1s, "timeout: the deadline is honoured");
+
+        auto [future, callback] = utils::makeFutureCallback<string_t>();
+        comm.httpGetAsync("/slow", callback);
+        check(errorOf([&future = future]{future.get();}) == ErrorCodeType::ERROR_TIMEOUT, "timeout: asynchronous request times out");
+    }
+
+    // Closed by the peer without an answer
+    {
+        LoopbackServer server;
+        iot::HttpComm  comm{"127.0.0.1", server.port()};
+
+        check(errorOf([&comm]{comm.httpGet("/reset");}) == ErrorCodeType::ERROR_CONNECTION_CLOSED, "peer close: a fresh connection is not retried");
+        check(server.received("/reset") == 1, "peer close: the request is sent once");
+    }
+
+    // Closed by the peer while idle: reads are retried, writes are not
+    {
+        LoopbackServer server;
+        iot::HttpComm  comm{"127.0.0.1", server.port()};
+
+        comm.httpGet("/close");
+        std::this_thread::sleep_for(50ms);
+        check(comm.httpGet("/getdata").find("OK") != string_t::npos, "idle close: a read is retried on a new connection");
+
+        comm.httpGet("/close");
+        std::this_thread::sleep_for(50ms);
+        auto error = errorOf([&comm]{comm.httpPost(R"({"adr":"/iolinkmaster/port[1]/iolinkdevice/pdout/setdata","cid":-1,"code":"request","data":{"newvalue":"00"}})");});
+        check(error == ErrorCodeType::ERROR_CONNECTION_CLOSED, "idle close: a write fails instead of being sent again");
+        check(server.received("/setdata") == 0, "idle close: the write is not sent on another connection");
+
+        comm.httpGet("/close");
+        std::this_thread::sleep_for(50ms);
+        auto [future, callback] = utils::makeFutureCallback<string_t>();
+        comm.httpGetAsync("/getdata", callback);
+        check(future.get().find("OK") != string_t::npos, "idle close: an asynchronous read is retried");
+    }
+
+    // A throwing callback is reported and does not stop the I/O thread
+    {
+        LoopbackServer server;
+        iot::HttpComm  comm{"127.0.0.1", server.port()};
+
+        std::atomic<int> reported{0};
+        utils::setUnhandledExceptionHandler([&reported](std::exception_ptr){++reported;});
+
+        comm.httpGetAsync("/getdata", [](string_t, std::exception_ptr){throw std::runtime_error{"callback"};});
+
+        auto [future, callback] = utils::makeFutureCallback<string_t>();
+        comm.httpGetAsync("/getdata", callback);
+        check(future.get().find("OK") != string_t::npos, "callback: the loop keeps running");
+        check(reported == 1, "callback: the exception is reported");
+
+        utils::setUnhandledExceptionHandler(nullptr);
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,238 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+
+#ifndef BITSTREAM_H
+#define BITSTREAM_H
+
+#include "exception.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace iolink::utils
+{
+    namespace detail
+    {
+        constexpr uint8_t lowBits(uint8_t bits) noexcept
+        {
+            return static_cast<uint8_t>((1u << bits) - 1);
+        }
+    }
+
+    /*
+     * Sequential reader of the bits of a contiguous buffer. The stream starts with the most significant bit of the
+     * first byte, which is the order of the elements of IO-Link arrays and records. Every read costs one step per byte
+     * it touches, so a whole array or record is decoded in a single pass over the buffer.
+     *
+     * readAt() addresses a field by its IO-Link bit offset instead: offset 0 is the least significant bit of the last
+     * byte.
+     */
+    class BitReader
+    {
+        public:
+            constexpr BitReader(const uint8_t *data, size_t size) noexcept:
+                m_data{data},
+                m_size{size * 8}
+            {}
+
+            // Length of the stream in bits
+            constexpr size_t size() const noexcept
+            {
+                return m_size;
+            }
+
+            constexpr size_t position() const noexcept
+            {
+                return m_position;
+            }
+
+            constexpr size_t remaining() const noexcept
+            {
+                return m_size - m_position;
+            }
+
+            // Moves to the bit at the position, counted from the start of the stream
+            constexpr void seek(size_t position)
+            {
+                if(position > m_size)
+                    throw iolink::utils::exception_argument(__func__, "Position past the end of the bit stream");
+
+                m_position = position;
+            }
+
+            constexpr void skip(size_t bits)
+            {
+                seek(m_position + bits);
+            }
+
+            // Reads up to 64 bits as an unsigned big endian number
+            constexpr uint64_t read(uint8_t bits)
+            {
+                if(bits > 64 || bits > remaining())
+                    throw iolink::utils::exception_argument(__func__, "Reading past the end of the bit stream");
+
+                uint64_t value = 0;
+
+                while(bits)
+                {
+                    const uint8_t available = 8 - (m_position & 7);
+                    const uint8_t count     = std::min(available, bits);
+                    const uint8_t byte      = m_data[m_position >> 3];
+
+                    value = (value << count) | ((byte >> (available - count)) & detail::lowBits(count));
+
+                    m_position += count;
+                    bits       -= count;
+                }
+
+                return value;
+            }
+
+            // Reads whole bytes. The bytes do not need to be aligned in the stream
+            void readBytes(uint8_t *output, size_t bytes)
+            {
+                if(bytes * 8 > remaining())
+                    throw iolink::utils::exception_argument(__func__, "Reading past the end of the bit stream");
+
+                if(m_position % 8 == 0)
+                {
+                    std::memcpy(output, m_data + m_position / 8, bytes);
+                    m_position += bytes * 8;
+                }
+                else
+                    for(size_t i = 0; i < bytes; ++i)
+                        output[i] = static_cast<uint8_t>(read(8));
+            }
+
+            // Reads the field at the IO-Link bit offset. The position of the stream does not change
+            constexpr uint64_t readAt(size_t offset, uint8_t bits) const
+            {
+                if(offset + bits > m_size)
+                    throw iolink::utils::exception_argument(__func__, "Field past the end of the bit stream");
+
+                BitReader reader{*this};
+                reader.m_position = m_size - offset - bits;
+
+                return reader.read(bits);
+            }
+
+        private:
+            const uint8_t *m_data;
+            size_t         m_size;
+            size_t         m_position = 0;
+    };
+
+    /*
+     * Sequential writer of the bits of a contiguous buffer, the counterpart of BitReader. The buffer is sized by the
+     * caller. Only the written bits are modified, the rest of the buffer is kept.
+     */
+    class BitWriter
+    {
+        public:
+            constexpr BitWriter(uint8_t *data, size_t size) noexcept:
+                m_data{data},
+                m_size{size * 8}
+            {}
+
+            constexpr size_t size() const noexcept
+            {
+                return m_size;
+            }
+
+            constexpr size_t position() const noexcept
+            {
+                return m_position;
+            }
+
+            constexpr size_t remaining() const noexcept
+            {
+                return m_size - m_position;
+            }
+
+            constexpr void seek(size_t position)
+            {
+                if(position > m_size)
+                    throw iolink::utils::exception_argument(__func__, "Position past the end of the bit stream");
+
+                m_position = position;
+            }
+
+            constexpr void skip(size_t bits)
+            {
+                seek(m_position + bits);
+            }
+
+            // Writes the low bits of the value, most significant first
+            constexpr void write(uint64_t value, uint8_t bits)
+            {
+                if(bits > 64 || bits > remaining())
+                    throw iolink::utils::exception_argument(__func__, "Writing past the end of the bit stream");
+
+                while(bits)
+                {
+                    const uint8_t available = 8 - (m_position & 7);
+                    const uint8_t count     = std::min(available, bits);
+                    const uint8_t shift     = available - count;
+                    const uint8_t chunk     = static_cast<uint8_t>(value >> (bits - count)) & detail::lowBits(count);
+                    uint8_t &byte           = m_data[m_position >> 3];
+
+                    byte = static_cast<uint8_t>((byte & ~(detail::lowBits(count) << shift)) | (chunk << shift));
+
+                    m_position += count;
+                    bits       -= count;
+                }
+            }
+
+            void writeBytes(const uint8_t *input, size_t bytes)
+            {
+                if(bytes * 8 > remaining())
+                    throw iolink::utils::exception_argument(__func__, "Writing past the end of the bit stream");
+
+                if(m_position % 8 == 0)
+                {
+                    std::memcpy(m_data + m_position / 8, input, bytes);
+                    m_position += bytes * 8;
+                }
+                else
+                    for(size_t i = 0; i < bytes; ++i)
+                        write(input[i], 8);
+            }
+
+            // Writes the field at the IO-Link bit offset. The position of the stream does not change
+            constexpr void writeAt(size_t offset, uint64_t value, uint8_t bits)
+            {
+                if(offset + bits > m_size)
+                    throw iolink::utils::exception_argument(__func__, "Field past the end of the bit stream");
+
+                BitWriter writer{*this};
+                writer.m_position = m_size - offset - bits;
+                writer.write(value, bits);
+            }
+
+        private:
+            uint8_t *m_data;
+            size_t   m_size;
+            size_t   m_position = 0;
+    };
+}
+
+#endif // BITSTREAM_H
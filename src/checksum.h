@@ -0,0 +1,200 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include "utils.h"
+
+namespace iolink::utils
+{
+    namespace detail
+    {
+        constexpr std::array<uint32_t, 256> makeCrc32Lut()
+        {
+            std::array<uint32_t, 256> lut{};
+
+            for(uint32_t i = 0; i < lut.size(); ++i)
+            {
+                uint32_t crc = i;
+
+                for(int bit = 0; bit < 8; ++bit)
+                    crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+
+                lut[i] = crc;
+            }
+
+            return lut;
+        }
+
+        inline constexpr std::array<uint32_t, 256> crc32_lut = makeCrc32Lut();
+    }
+
+    /*
+     * CRC-32 as used by zlib and Ethernet. Pass the result of the previous call to continue the checksum over the next
+     * chunk of data.
+     */
+    inline uint32_t crc32(const uint8_t *data, size_t length, uint32_t crc = 0) noexcept
+    {
+        crc = ~crc;
+
+        for(size_t i = 0; i < length; ++i)
+            crc = detail::crc32_lut[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+
+        return ~crc;
+    }
+
+    // MD5 digest computed chunk by chunk
+    class Md5
+    {
+        public:
+            using digest_t = std::array<uint8_t, 16>;
+
+            void update(const uint8_t *data, size_t length) noexcept
+            {
+                size_t buffered = static_cast<size_t>(m_length % 64);
+                m_length += length;
+
+                if(buffered)
+                {
+                    const size_t count = std::min(length, 64 - buffered);
+                    std::memcpy(m_buffer.data() + buffered, data, count);
+                    data   += count;
+                    length -= count;
+
+                    if(buffered + count < 64)
+                        return;
+
+                    transform(m_buffer.data());
+                }
+
+                for(; length >= 64; data += 64, length -= 64)
+                    transform(data);
+
+                std::memcpy(m_buffer.data(), data, length);
+            }
+
+            // The object must not be updated afterwards
+            digest_t finish() noexcept
+            {
+                const uint64_t bits = m_length * 8;
+
+                static const uint8_t padding[64] = {0x80};
+                const size_t buffered = static_cast<size_t>(m_length % 64);
+                update(padding, buffered < 56 ? 56 - buffered : 120 - buffered);
+
+                uint8_t length[8];
+                for(int i = 0; i < 8; ++i)
+                    length[i] = static_cast<uint8_t>(bits >> (8 * i));
+
+                update(length, sizeof(length));
+
+                digest_t digest;
+                for(int i = 0; i < 4; ++i)
+                    for(int j = 0; j < 4; ++j)
+                        digest[4 * i + j] = static_cast<uint8_t>(m_state[i] >> (8 * j));
+
+                return digest;
+            }
+
+            static digest_t digest(const uint8_t *data, size_t length) noexcept
+            {
+                Md5 md5;
+                md5.update(data, length);
+                return md5.finish();
+            }
+
+        private:
+            void transform(const uint8_t *block) noexcept
+            {
+                static constexpr uint32_t k[64] =
+                {
+                    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+                    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+                    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+                    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+                    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+                    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+                    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+                    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+                };
+
+                static constexpr uint8_t r[64] =
+                {
+                    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+                    5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20,
+                    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+                    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+                };
+
+                uint32_t w[16];
+                for(int i = 0; i < 16; ++i)
+                    w[i] = uint32_t(block[4 * i]) | uint32_t(block[4 * i + 1]) << 8 | uint32_t(block[4 * i + 2]) << 16 | uint32_t(block[4 * i + 3]) << 24;
+
+                uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+
+                for(int i = 0; i < 64; ++i)
+                {
+                    uint32_t f;
+                    int g;
+
+                    if(i < 16)
+                    {
+                        f = (b & c) | (~b & d);
+                        g = i;
+                    }
+                    else if(i < 32)
+                    {
+                        f = (d & b) | (~d & c);
+                        g = (5 * i + 1) % 16;
+                    }
+                    else if(i < 48)
+                    {
+                        f = b ^ c ^ d;
+                        g = (3 * i + 5) % 16;
+                    }
+                    else
+                    {
+                        f = c ^ (b | ~d);
+                        g = (7 * i) % 16;
+                    }
+
+                    const uint32_t rotate = a + f + k[i] + w[g];
+
+                    a = d;
+                    d = c;
+                    c = b;
+                    b = b + (rotate << r[i] | rotate >> (32 - r[i]));
+                }
+
+                m_state[0] += a;
+                m_state[1] += b;
+                m_state[2] += c;
+                m_state[3] += d;
+            }
+
+        private:
+            std::array<uint32_t, 4> m_state{0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+            std::array<uint8_t, 64> m_buffer{};
+            uint64_t                m_length = 0;
+    };
+}
+
+#endif // CHECKSUM_H
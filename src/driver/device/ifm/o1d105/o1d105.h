@@ -23,6 +23,8 @@
 
 #include "../../../../iodd/iodd_basedriver.h"
 #include "../../../../iodd/iodd_dataaccess.h"
+#include "../../../../iodd/iodd_parametertable.h"
+#include "../../../../iodd/iodd_processdata.h"
 #include "../../../../iodd/iodd_datatypestring.h"
 #include "../../../../iodd/iodd_datatypeuint.h"
 #include "../../../../iodd/iodd_datatypeint.h"
@@ -40,13 +42,20 @@ namespace iolink::driver
 
             struct ProcessData
             {
-                    const int16_t distance = 0;
-                    const int16_t reflectivity = 0;
-                    const uint8_t status = 0;
-                    const bool    out1 = false;
-                    const bool    out2 = false;
+                    int16_t distance = 0;
+                    int16_t reflectivity = 0;
+                    uint8_t status = 0;
+                    bool    out1 = false;
+                    bool    out2 = false;
             };
 
+            using ProcessDataLayout = iolink::iodd::ProcessDataLayout<ProcessData, 8,
+                                                                      Field<&ProcessData::distance,     48, IntegerT<16>>,
+                                                                      Field<&ProcessData::reflectivity, 16, IntegerT<16>>,
+                                                                      Field<&ProcessData::status,        4, UIntegerT<4>>,
+                                                                      Field<&ProcessData::out1,          0, BooleanT>,
+                                                                      Field<&ProcessData::out2,          1, BooleanT>>;
+
             O1D105() =delete;
             O1D105(const O1D105&) =delete;
             O1D105(O1D105&&) =delete;
@@ -61,17 +70,50 @@ namespace iolink::driver
 
             ProcessData processData() const
             {
-                auto data = hexDecode<iolink::vector_t>(getIOLinkDevice()->pdin.getData());
-
-                ProcessData reading = {
-                    .distance     = int16_t((int16_t(data[0]) << 8) | int16_t(data[1])),
-                    .reflectivity = int16_t((int16_t(data[4]) << 8) | int16_t(data[5])),
-                    .status       = uint8_t(data[7] >> 4),
-                    .out1         = (data[7] & 0x01)?true:false,
-                    .out2         = (data[7] & 0x02)?true:false
-                };
+                return ProcessDataLayout::decode(getIOLinkDevice()->pdin.getData());
+            }
 
-                return reading;
+            static constexpr auto parameters()
+            {
+                return std::make_tuple(IOLINK_PARAMETER(O1D105, standard_command),
+                                       IOLINK_PARAMETER(O1D105, vendor_name),
+                                       IOLINK_PARAMETER(O1D105, vendor_text),
+                                       IOLINK_PARAMETER(O1D105, product_name),
+                                       IOLINK_PARAMETER(O1D105, product_id),
+                                       IOLINK_PARAMETER(O1D105, product_text),
+                                       IOLINK_PARAMETER(O1D105, serial_number),
+                                       IOLINK_PARAMETER(O1D105, firmware_version),
+                                       IOLINK_PARAMETER(O1D105, software_version),
+                                       IOLINK_PARAMETER(O1D105, application_tag),
+                                       IOLINK_PARAMETER(O1D105, device_status),
+                                       IOLINK_PARAMETER(O1D105, detailed_device_status),
+                                       IOLINK_PARAMETER(O1D105, ti_selection),
+                                       IOLINK_PARAMETER(O1D105, dS1),
+                                       IOLINK_PARAMETER(O1D105, dr1),
+                                       IOLINK_PARAMETER(O1D105, dS2),
+                                       IOLINK_PARAMETER(O1D105, dr2),
+                                       IOLINK_PARAMETER(O1D105, dFo),
+                                       IOLINK_PARAMETER(O1D105, power_cycles),
+                                       IOLINK_PARAMETER(O1D105, operating_hours),
+                                       IOLINK_PARAMETER(O1D105, param_config_fault),
+                                       IOLINK_PARAMETER(O1D105, loc),
+                                       IOLINK_PARAMETER(O1D105, uni),
+                                       IOLINK_PARAMETER(O1D105, ou1),
+                                       IOLINK_PARAMETER(O1D105, sp1),
+                                       IOLINK_PARAMETER(O1D105, ou2),
+                                       IOLINK_PARAMETER(O1D105, sp2),
+                                       IOLINK_PARAMETER(O1D105, asp),
+                                       IOLINK_PARAMETER(O1D105, aep),
+                                       IOLINK_PARAMETER(O1D105, dis_u),
+                                       IOLINK_PARAMETER(O1D105, dis_r),
+                                       IOLINK_PARAMETER(O1D105, dis_b),
+                                       IOLINK_PARAMETER(O1D105, transmitter_configuration),
+                                       IOLINK_PARAMETER(O1D105, rate),
+                                       IOLINK_PARAMETER(O1D105, rep_r),
+                                       IOLINK_PARAMETER(O1D105, fsp1),
+                                       IOLINK_PARAMETER(O1D105, nsp1),
+                                       IOLINK_PARAMETER(O1D105, fsp2),
+                                       IOLINK_PARAMETER(O1D105, nsp2));
             }
 
             //            std::tuple<int16_t, int16_t, uint8_t, bool, bool> processData() const
@@ -124,7 +166,7 @@ namespace iolink::driver
             Read<541, 0, IntegerT<32>> power_cycles{this, 0, 2147483647};
             Read<542, 0, IntegerT<32>> operating_hours{this, 0, 2147483647};
             // 545 active_events
-            Read<546, 0, ArrayT<UIntegerT<32>, 10>> param_config_fault{this};
+            Read<546, 0, ArrayT<UIntegerT<32>, 10, true>> param_config_fault{this};
             ReadWrite<550, 0, UIntegerT<8>> loc{this, iolink::map_t<uint8_t>{ {0, "Loc"},
                                                                               {1, "uLoc"}
                                                                             }};
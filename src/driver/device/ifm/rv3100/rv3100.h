@@ -22,6 +22,8 @@
 #define RV3100_H
 
 #include "../../../../iodd/iodd_dataaccess.h"
+#include "../../../../iodd/iodd_parametertable.h"
+#include "../../../../iodd/iodd_processdata.h"
 #include "../../../../iodd/iodd_datatypestring.h"
 #include "../../../../iodd/iodd_datatypeuint.h"
 #include "../../../../iodd/iodd_datatypeint.h"
@@ -37,13 +39,20 @@ namespace iolink::driver
 
             struct ProcessData
             {
-                    const int16_t distance = 0;
-                    const int16_t reflectivity = 0;
-                    const uint8_t status = 0;
-                    const bool    out1 = false;
-                    const bool    out2 = false;
+                    int16_t distance = 0;
+                    int16_t reflectivity = 0;
+                    uint8_t status = 0;
+                    bool    out1 = false;
+                    bool    out2 = false;
             };
 
+            using ProcessDataLayout = iolink::iodd::ProcessDataLayout<ProcessData, 8,
+                                                                      Field<&ProcessData::distance,     48, IntegerT<16>>,
+                                                                      Field<&ProcessData::reflectivity, 16, IntegerT<16>>,
+                                                                      Field<&ProcessData::status,        4, UIntegerT<4>>,
+                                                                      Field<&ProcessData::out1,          0, BooleanT>,
+                                                                      Field<&ProcessData::out2,          1, BooleanT>>;
+
             RV3100() =delete;
             RV3100(const RV3100&) =delete;
             RV3100(RV3100&&) =delete;
@@ -58,17 +67,20 @@ namespace iolink::driver
 
             ProcessData processData() const
             {
-                auto data = iolink::utils::hexDecode<iolink::vector_t>(getIOLinkDevice()->pdin.getData());
-
-                ProcessData reading = {
-                    .distance     = int16_t((int16_t(data[0]) << 8) | int16_t(data[1])),
-                    .reflectivity = int16_t((int16_t(data[4]) << 8) | int16_t(data[5])),
-                    .status       = uint8_t(data[7] >> 4),
-                    .out1         = (data[7] & 0x01)?true:false,
-                    .out2         = (data[7] & 0x02)?true:false
-                };
+                return ProcessDataLayout::decode(getIOLinkDevice()->pdin.getData());
+            }
 
-                return reading;
+            static constexpr auto parameters()
+            {
+                return std::make_tuple(IOLINK_PARAMETER(RV3100, vendor_name),
+                                       IOLINK_PARAMETER(RV3100, vendor_text),
+                                       IOLINK_PARAMETER(RV3100, product_name),
+                                       IOLINK_PARAMETER(RV3100, product_id),
+                                       IOLINK_PARAMETER(RV3100, product_text),
+                                       IOLINK_PARAMETER(RV3100, serial_number),
+                                       IOLINK_PARAMETER(RV3100, firmware_version),
+                                       IOLINK_PARAMETER(RV3100, software_version),
+                                       IOLINK_PARAMETER(RV3100, application_tag));
             }
 
             Read<16, 0, StringT> vendor_name{this, 19_ui32};
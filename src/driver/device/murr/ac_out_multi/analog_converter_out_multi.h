@@ -3,6 +3,7 @@
 
 #include "../../../../iodd/iodd_basedriver.h"
 #include "../../../../iodd/iodd_dataaccess.h"
+#include "../../../../iodd/iodd_parametertable.h"
 #include "../../../../iodd/iodd_datatypestring.h"
 #include "../../../../iodd/iodd_datatypeuint.h"
 #include "../../../../iodd/iodd_datatypeint.h"
@@ -38,6 +39,11 @@ namespace iolink::driver
                 BaseDriver(iolink_device, 303, 264128)
             {}
 
+            static constexpr auto parameters()
+            {
+                return std::make_tuple();
+            }
+
             //        ProcessData processData() const
             //        {
             //            auto data = iolink::utils::hexDecode<iolink::vector_t>(getIOLinkDevice()->pdin.getData());
@@ -21,7 +21,8 @@
 #ifndef AL1352_FIRMWARE_H
 #define AL1352_FIRMWARE_H
 
-#include "../../../iot/profileblob.h"
+#include "../../../iot/blobtransfer.h"
+#include "../../../mappedfile.h"
 #include "../../../iot/profilesoftware.h"
 #include "../../../iot/profileuploadablesoftware.h"
 
@@ -81,6 +82,22 @@ namespace iolink::master::al1352
             json_t signal(){return ProfileSoftware::requestGet("/signal");}
             json_t reboot(){return ProfileSoftware::requestGet("/reboot");}
 
+            // Uploads the image into the container and installs it
+            void update(const uint8_t *image, size_t size, const progress_t &progress = nullptr) const
+            {
+                if(static_cast<uint64_t>(container.maxsize.getData()) < size)
+                    throw iolink::utils::exception_argument(__func__, "Firmware image is larger than the container");
+
+                uploadBlob(container, image, size, progress);
+                install();
+            }
+
+            void update(const string_t &path, const progress_t &progress = nullptr) const
+            {
+                const utils::MappedFile image{path};
+                update(image.data(), image.size(), progress);
+            }
+
         private:
             using ProfileUploadableSoftware::lastinstall;
             using ProfileUploadableSoftware::installhistory;
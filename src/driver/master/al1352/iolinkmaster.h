@@ -21,8 +21,11 @@
 #ifndef AL1352_IOLINKMASTER_H
 #define AL1352_IOLINKMASTER_H
 
-#include "libiolink/iot/profileblob.h"
-#include "libiolink/iot/profileiolinkmaster.h"
+#include "../../../iot/profileblob.h"
+#include "../../../iot/profileiolinkmaster.h"
+
+#include <array>
+#include <chrono>
 
 namespace iolink::master::al1352
 {
@@ -62,6 +65,22 @@ namespace iolink::master::al1352
             using ProfileIOLinkMaster::additionalpins_out;
     };
 
+    // Process data of all ports read at the same moment by IOLinkMaster::snapshotProcessData()
+    struct ProcessDataSnapshot
+    {
+        struct PortData
+        {
+            std::array<uint8_t, 32> pdin{};         // Decoded process data input. Only the first "length" bytes are valid
+            uint8_t                 length = 0;
+            int64_t                 pin2in = 0;
+            int16_t                 status = 0;     // Same values as ProfileIOLinkDevice::status
+            bool                    valid  = false; // False if the master reported an error for the pdin of this port
+        };
+
+        std::array<PortData, 8>                ports;
+        std::chrono::system_clock::time_point  timestamp;  // Time when the response was received
+    };
+
     class IOLinkMaster: private BaseElement
     {
         public:
@@ -69,6 +88,72 @@ namespace iolink::master::al1352
                 BaseElement ("iolinkmaster", parent)
             {};
 
+            /*
+             * Reads the pdin of all the ports and optionally pin2in and status with a single consistent /getdatamulti
+             * request.
+             */
+            ProcessDataSnapshot snapshotProcessData(bool with_pin2in = false, bool with_status = false) const
+            {
+                const std::array<const Port*, 8> ports{&port1, &port2, &port3, &port4, &port5, &port6, &port7, &port8};
+
+                std::vector<string_t> element_urls;
+                element_urls.reserve(ports.size() * 3);
+
+                for(const auto port: ports)
+                {
+                    element_urls.push_back(port->iolinkdevice.pdin.address());
+
+                    if(with_pin2in)
+                        element_urls.push_back(port->pin2in.address());
+
+                    if(with_status)
+                        element_urls.push_back(port->iolinkdevice.status.address());
+                }
+
+                const json_t response = requestDataMulti(std::move(element_urls), true);
+                const json_t &data    = response.at("data");
+
+                ProcessDataSnapshot snapshot;
+                snapshot.timestamp = std::chrono::system_clock::now();
+
+                // Returns nullptr if the element is missing from the response or the master reported an error for it
+                auto value = [&data](const string_t &url) -> const json_t*
+                {
+                    auto it = data.find(url);
+                    if(it == data.end() || !it->contains("code") || (*it)["code"] != 200)
+                        return nullptr;
+
+                    return &(*it)["data"];
+                };
+
+                for(size_t i = 0; i < ports.size(); ++i)
+                {
+                    auto &port_data = snapshot.ports[i];
+
+                    if(auto pdin = value(ports[i]->iolinkdevice.pdin.address()))
+                    {
+                        const auto bytes = utils::hexDecode<vector_t>(pdin->get<string_t>());
+
+                        if(bytes.size() > port_data.pdin.size())
+                            throw iolink::utils::exception_master(__func__, iolink::utils::exception_master::ErrorCodeType::BAD_RESPONSE);
+
+                        std::copy(bytes.begin(), bytes.end(), port_data.pdin.begin());
+                        port_data.length = static_cast<uint8_t>(bytes.size());
+                        port_data.valid  = true;
+                    }
+
+                    if(with_pin2in)
+                        if(auto pin2in = value(ports[i]->pin2in.address()))
+                            port_data.pin2in = pin2in->get<int64_t>();
+
+                    if(with_status)
+                        if(auto status = value(ports[i]->iolinkdevice.status.address()))
+                            port_data.status = status->get<int16_t>();
+                }
+
+                return snapshot;
+            }
+
             Port port1{"port[1]", this};
             Port port2{"port[2]", this};
             Port port3{"port[3]", this};
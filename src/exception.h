@@ -23,6 +23,8 @@
 
 #include "inc.h"
 
+#include <mutex>
+
 namespace iolink::utils
 {
     class exception_argument: public std::invalid_argument
@@ -153,6 +155,185 @@ namespace iolink::utils
                 {ErrorCodeType::ERROR_INVALID_VALUE, "Invalid value"}
             };
     };
+
+    class exception_comm: public std::exception
+    {
+        public:
+            enum class ErrorCodeType: int{ERROR_CONNECT = 0,
+                                          ERROR_TIMEOUT = 1,
+                                          ERROR_CONNECTION_CLOSED = 2,
+                                          ERROR_IO = 3,
+                                          ERROR_TOO_LARGE = 4,
+                                          BAD_RESPONSE = -1};
+
+            exception_comm(const string_t &func_name, ErrorCodeType error, const string_t &message = string_t{}):
+                m_func_name{func_name},
+                m_error_code{error}
+            {
+                m_error = "Function[" + ((func_name.length() != 0)? func_name + "()":string_t{}) + "] " +
+                          "Error["    + m_error_list.at(error) +
+                          ((message.length() != 0)? " #" + message:string_t{}) +
+                          "]";
+            }
+
+            explicit exception_comm(ErrorCodeType error, const string_t &message = string_t{}):
+                exception_comm{string_t{}, error, message}
+            {
+            }
+
+            ErrorCodeType error_code() const noexcept
+            {
+                return m_error_code;
+            }
+
+            string_t error() const noexcept
+            {
+                return m_error;
+            }
+
+            const char* what() const noexcept override
+            {
+                return m_error.c_str();
+            }
+
+        private:
+            const string_t   m_func_name;
+            const ErrorCodeType m_error_code;
+            string_t   m_error;
+            inline static const std::unordered_map<ErrorCodeType, const string_t> m_error_list
+            {
+                {ErrorCodeType::ERROR_CONNECT, "Can not connect"},
+                {ErrorCodeType::ERROR_TIMEOUT, "Timeout"},
+                {ErrorCodeType::ERROR_CONNECTION_CLOSED, "Connection closed by peer"},
+                {ErrorCodeType::ERROR_IO, "Input/Output error"},
+                {ErrorCodeType::ERROR_TOO_LARGE, "Message too large"},
+                {ErrorCodeType::BAD_RESPONSE, "Bad response"}
+            };
+    };
+
+    // Failures of several parameters that were processed together. Every failed parameter is listed with its error
+    class exception_parameters: public std::exception
+    {
+        public:
+            using key_t      = std::pair<uint32_t, uint32_t>;  // Index and subindex
+            using failures_t = std::vector<std::pair<key_t, std::exception_ptr>>;
+
+            exception_parameters(const string_t &func_name, failures_t failures):
+                m_func_name{func_name},
+                m_failures{std::move(failures)}
+            {
+                string_t list;
+
+                for(const auto &[key, error]: m_failures)
+                {
+                    list += (list.empty() ? "" : ", ") + std::to_string(key.first) + "/" + std::to_string(key.second);
+
+                    try
+                    {
+                        if(error)
+                            std::rethrow_exception(error);
+                    }
+                    catch(const std::exception &e)
+                    {
+                        list += string_t(" ") + e.what();
+                    }
+                    catch(...)
+                    {
+                    }
+                }
+
+                m_error = "Function[" + ((func_name.length() != 0)? func_name + "()":string_t{}) + "] " +
+                          "Error[" + std::to_string(m_failures.size()) + " parameters failed: " + list + "]";
+            }
+
+            const failures_t& failures() const noexcept
+            {
+                return m_failures;
+            }
+
+            string_t error() const noexcept
+            {
+                return m_error;
+            }
+
+            const char* what() const noexcept override
+            {
+                return m_error.c_str();
+            }
+
+        private:
+            const string_t   m_func_name;
+            const failures_t m_failures;
+            string_t         m_error;
+    };
+
+    /*
+     * Receives the exceptions thrown by user callbacks on the threads of the library, where there is no caller to
+     * rethrow them to. By default they are ignored. The handler runs on the thread that caught the exception and must
+     * not throw.
+     */
+    using unhandled_handler_t = std::function<void(std::exception_ptr)>;
+
+    namespace detail
+    {
+        struct UnhandledHandler
+        {
+            std::mutex          mutex;
+            unhandled_handler_t handler;
+        };
+
+        inline UnhandledHandler& unhandledHandler()
+        {
+            static UnhandledHandler instance;
+            return instance;
+        }
+    }
+
+    inline void setUnhandledExceptionHandler(unhandled_handler_t handler)
+    {
+        auto &instance = detail::unhandledHandler();
+        std::lock_guard lock{instance.mutex};
+        instance.handler = std::move(handler);
+    }
+
+    inline void reportUnhandledException(std::exception_ptr error) noexcept
+    {
+        unhandled_handler_t handler;
+
+        {
+            auto &instance = detail::unhandledHandler();
+            std::lock_guard lock{instance.mutex};
+            handler = instance.handler;
+        }
+
+        if(handler)
+        {
+            try
+            {
+                handler(error);
+            }
+            catch(...)
+            {
+            }
+        }
+    }
+
+    /*
+     * Invokes a user callback and reports whatever it throws instead of letting it escape into the thread of the
+     * library.
+     */
+    template<typename Callable, typename ... Args>
+    void invokeGuarded(Callable &&callable, Args&& ... args) noexcept
+    {
+        try
+        {
+            std::forward<Callable>(callable)(std::forward<Args>(args)...);
+        }
+        catch(...)
+        {
+            reportUnhandledException(std::current_exception());
+        }
+    }
 }
 
 #endif // EXCEPTION_H
@@ -32,6 +32,8 @@
 #include <variant>
 #include <vector>
 #include <string>
+#include <functional>
+#include <future>
 
 #include "lib/json.hpp"
 
@@ -50,6 +52,22 @@ namespace iolink
 
     template<typename T>
     using map_t = std::unordered_map<T, const string_t>;
+
+    // Completion handler of asynchronous operations. Exactly one of the value or the error is meaningful
+    template<typename T>
+    struct callback_traits
+    {
+        using type = std::function<void(T value, std::exception_ptr error)>;
+    };
+
+    template<>
+    struct callback_traits<void>
+    {
+        using type = std::function<void(std::exception_ptr error)>;
+    };
+
+    template<typename T>
+    using callback_t = typename callback_traits<T>::type;
 }
 
 #endif // INC_LIB_H
@@ -22,6 +22,7 @@
 #define IODD_BASEDRIVER_H
 
 #include "../iot/profileiolinkdevice.h"
+#include "iodd_parametercache.h"
 
 namespace iolink::iodd
 {
@@ -45,6 +46,175 @@ namespace iolink::iodd
                 throw iolink::utils::exception_logic(__func__, "Can't create a shared pointer to IOLinkDevice");
             }
 
+            /*
+             * Enables the parameter cache of this driver. Nothing is cached until a TTL is set, either the default one
+             * or per parameter through the returned object. The cache is dropped together with the driver on
+             * driverDetach() and is invalidated when the device leaves the operate state.
+             */
+            ParameterCache& enableCache(ParameterCache::duration_t default_ttl = ParameterCache::duration_t::zero())
+            {
+                if(!m_cache)
+                    m_cache = std::make_shared<ParameterCache>(default_ttl);
+                else
+                    m_cache->setDefaultTtl(default_ttl);
+
+                return *m_cache;
+            }
+
+            void disableCache()
+            {
+                m_cache.reset();
+            }
+
+            // Returns nullptr if the cache is not enabled
+            ParameterCache* cache() const
+            {
+                return m_cache.get();
+            }
+
+            // Reads a parameter through the cache, if it is enabled
+            template<typename T>
+            T readParameter(uint32_t index, uint32_t sub_index) const
+            {
+                auto device = getIOLinkDevice();
+
+                if(!m_cache)
+                    return device->template read<T>(index, sub_index);
+
+                try
+                {
+                    if(m_cache->statusCheckDue() && device->status.getData() != STATE_OPERATE)
+                        m_cache->invalidate();
+
+                    if(auto value = m_cache->find(index, sub_index))
+                        return utils::hexDecode<T>(*value);
+
+                    auto value = device->readHex(index, sub_index);
+                    m_cache->store(index, sub_index, value);
+
+                    return utils::hexDecode<T>(value);
+                }
+                catch(...)
+                {
+                    m_cache->invalidate();
+                    throw;
+                }
+            }
+
+            template<typename T>
+            void readParameterAsync(uint32_t index, uint32_t sub_index, callback_t<T> callback) const
+            {
+                auto device = getIOLinkDevice();
+
+                if(!m_cache)
+                    return device->template readAsync<T>(index, sub_index, std::move(callback));
+
+                auto read = [device, cache = m_cache, index, sub_index, callback = std::move(callback)]() mutable
+                {
+                    if(auto value = cache->find(index, sub_index))
+                    {
+                        T decoded{};
+
+                        try
+                        {
+                            decoded = utils::hexDecode<T>(*value);
+                        }
+                        catch(...)
+                        {
+                            return callback(std::move(decoded), std::current_exception());
+                        }
+
+                        return callback(std::move(decoded), nullptr);
+                    }
+
+                    device->readHexAsync(index, sub_index, [cache, index, sub_index, callback = std::move(callback)](string_t value, std::exception_ptr error)
+                    {
+                        T decoded{};
+
+                        if(!error)
+                        {
+                            try
+                            {
+                                decoded = utils::hexDecode<T>(value);
+                                cache->store(index, sub_index, value);
+                            }
+                            catch(...)
+                            {
+                                error = std::current_exception();
+                            }
+                        }
+
+                        if(error)
+                            cache->invalidate();
+
+                        callback(std::move(decoded), error);
+                    });
+                };
+
+                if(!m_cache->statusCheckDue())
+                    return read();
+
+                device->status.getDataAsync([cache = m_cache, read = std::move(read)](int16_t status, std::exception_ptr error) mutable
+                {
+                    if(error || status != STATE_OPERATE)
+                        cache->invalidate();
+
+                    read();
+                });
+            }
+
+            /*
+             * Writes a parameter and updates the cache, if it is enabled. The other subindices of the index are
+             * dropped from the cache, as the write may change them.
+             */
+            template<typename T>
+            void writeParameter(T value, uint32_t index, uint32_t sub_index) const
+            {
+                auto device = getIOLinkDevice();
+                auto hex    = utils::hexEncode(std::forward<T>(value));
+
+                try
+                {
+                    device->iolWriteAcyclic(hex, index, sub_index);
+                }
+                catch(...)
+                {
+                    if(m_cache)
+                        m_cache->invalidateIndex(index);
+
+                    throw;
+                }
+
+                if(m_cache)
+                {
+                    m_cache->invalidateIndex(index);
+                    m_cache->store(index, sub_index, hex);
+                }
+            }
+
+            template<typename T>
+            void writeParameterAsync(T value, uint32_t index, uint32_t sub_index, callback_t<void> callback) const
+            {
+                writeParameterHexAsync(utils::hexEncode(std::forward<T>(value)), index, sub_index, std::move(callback));
+            }
+
+            // Writes an already encoded value and updates the cache, if it is enabled
+            void writeParameterHexAsync(const string_t &hex, uint32_t index, uint32_t sub_index, callback_t<void> callback) const
+            {
+                getIOLinkDevice()->iolWriteAcyclicAsync(hex, index, sub_index, [cache = m_cache, hex, index, sub_index, callback = std::move(callback)](json_t, std::exception_ptr error)
+                {
+                    if(cache)
+                    {
+                        cache->invalidateIndex(index);
+
+                        if(!error)
+                            cache->store(index, sub_index, hex);
+                    }
+
+                    callback(error);
+                });
+            }
+
         protected:
             BaseDriver(const std::weak_ptr<iolink::iot::ProfileIOLinkDevice>& iolink_device, int id_vendor, int id_device, bool check = true):
                 m_vendor_id{id_vendor},
@@ -68,7 +238,11 @@ namespace iolink::iodd
             const int m_device_id;
 
         private:
+            // Value of ProfileIOLinkDevice::status while the device exchanges data
+            static constexpr int16_t STATE_OPERATE = 2;
+
             std::weak_ptr<iolink::iot::ProfileIOLinkDevice> m_iolink_device;
+            std::shared_ptr<ParameterCache>                 m_cache;
     };
 }
 
@@ -0,0 +1,263 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef IODD_CONFIGURATION_H
+#define IODD_CONFIGURATION_H
+
+#include "iodd_parameterset.h"
+
+#include <cctype>
+
+namespace iolink::iodd
+{
+    namespace detail
+    {
+        inline string_t upper(string_t hex)
+        {
+            for(auto &ch: hex)
+                ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+
+            return hex;
+        }
+
+        // Throws exception_parameters listing every failed parameter of the results, if there is one
+        inline void throwErrors(const std::map<ParameterSet::key_t, ParameterResult> &results, const char *func_name)
+        {
+            iolink::utils::exception_parameters::failures_t failures;
+
+            for(const auto &[key, result]: results)
+                if(result.error)
+                    failures.emplace_back(key, result.error);
+
+            if(!failures.empty())
+                throw iolink::utils::exception_parameters(func_name, std::move(failures));
+        }
+    }
+
+    /*
+     * Values of the writable parameters of a device, stored as the raw hex strings exchanged with the device. It is
+     * created by snapshot() and restored by apply(), usually on the replacement of a swapped device.
+     *
+     * Example:
+     *
+     *     auto config = iolink::iodd::snapshot(*o1d105_drv);
+     *     save(config.toJson().dump());
+     *     ...
+     *     auto written = iolink::iodd::apply(*o1d105_drv, iolink::iodd::Configuration::fromJson(json));
+     */
+    class Configuration
+    {
+        public:
+            using key_t = ParameterSet::key_t;
+
+            struct Entry
+            {
+                string_t name;
+                string_t value;
+            };
+
+            // The hex value is stored in upper case
+            void set(uint32_t index, uint32_t sub_index, string_t name, string_t value)
+            {
+                m_entries[{index, sub_index}] = Entry{std::move(name), detail::upper(std::move(value))};
+            }
+
+            bool contains(uint32_t index, uint32_t sub_index) const
+            {
+                return m_entries.count({index, sub_index}) != 0;
+            }
+
+            const string_t& value(uint32_t index, uint32_t sub_index) const
+            {
+                auto it = m_entries.find({index, sub_index});
+
+                if(it == m_entries.end())
+                    throw iolink::utils::exception_argument(__func__, "Parameter is not part of the configuration");
+
+                return it->second.value;
+            }
+
+            void remove(uint32_t index, uint32_t sub_index)
+            {
+                m_entries.erase({index, sub_index});
+            }
+
+            const std::map<key_t, Entry>& entries() const
+            {
+                return m_entries;
+            }
+
+            size_t size() const
+            {
+                return m_entries.size();
+            }
+
+            bool empty() const
+            {
+                return m_entries.empty();
+            }
+
+            json_t toJson() const
+            {
+                json_t json = json_t::array();
+
+                for(const auto &[key, entry]: m_entries)
+                    json.push_back({{"index", key.first}, {"subindex", key.second}, {"name", entry.name}, {"value", entry.value}});
+
+                return json;
+            }
+
+            static Configuration fromJson(const json_t &json)
+            {
+                if(!json.is_array())
+                    throw iolink::utils::exception_argument(__func__, "Configuration must be a JSON array");
+
+                Configuration config;
+
+                try
+                {
+                    for(const auto &entry: json)
+                        config.set(entry.at("index").get<uint32_t>(),
+                                   entry.at("subindex").get<uint32_t>(),
+                                   entry.value("name", string_t{}),
+                                   entry.at("value").get<string_t>());
+                }
+                catch(const json_t::exception &e)
+                {
+                    throw iolink::utils::exception_argument(__func__, e.what());
+                }
+
+                return config;
+            }
+
+        private:
+            std::map<key_t, Entry> m_entries;
+    };
+
+    // Reads all the parameters of the driver that can be read and written back
+    template<typename Driver>
+    Configuration snapshot(const Driver &driver)
+    {
+        ParameterSet set{driver};
+
+        forEachParameter<Driver>([&set](const auto &info)
+        {
+            using info_t = std::decay_t<decltype(info)>;
+
+            if constexpr(info_t::readable && info_t::writable)
+                set.read(info_t::index, info_t::sub_index);
+        });
+
+        set.execute();
+
+        auto results = set.results();
+        detail::throwErrors(results, __func__);
+
+        Configuration config;
+
+        forEachParameter<Driver>([&config, &results](const auto &info)
+        {
+            using info_t = std::decay_t<decltype(info)>;
+
+            if constexpr(info_t::readable && info_t::writable)
+                config.set(info_t::index, info_t::sub_index, info.name, results[{info_t::index, info_t::sub_index}].value);
+        });
+
+        return config;
+    }
+
+    /*
+     * Writes only the parameters of the configuration whose value differs from the one of the device. Every value is
+     * validated before anything is read or written. Returns the number of written parameters.
+     *
+     * The current values are read together, but the writes are sent one after another in the order of the parameter
+     * table of the driver, because a device may validate a parameter against the ones written before it. A failed
+     * write does not stop the others. Every failed parameter is reported with exception_parameters afterwards.
+     */
+    template<typename Driver>
+    size_t apply(const Driver &driver, const Configuration &config)
+    {
+        std::vector<Configuration::key_t> order;
+
+        forEachParameter<Driver>([&driver, &config, &order](const auto &info)
+        {
+            using info_t = std::decay_t<decltype(info)>;
+
+            if(!config.contains(info_t::index, info_t::sub_index))
+                return;
+
+            if constexpr(info_t::writable)
+            {
+                const auto &parameter = info.get(driver);
+
+                if(!parameter.isValid(parameter.toType(utils::hexDecode<typename info_t::iodd_type_t>(config.value(info_t::index, info_t::sub_index)))))
+                    throw iolink::utils::exception_iodd(__func__, iolink::utils::exception_iodd::ErrorCodeType::ERROR_INVALID_VALUE);
+
+                order.emplace_back(info_t::index, info_t::sub_index);
+            }
+            else
+                throw iolink::utils::exception_argument(__func__, string_t("Parameter is not writable: ") + info.name);
+        });
+
+        if(order.size() != config.size())
+            throw iolink::utils::exception_argument(__func__, "Configuration contains parameters that the driver does not have");
+
+        ParameterSet reads{driver};
+
+        for(const auto &[key, entry]: config.entries())
+            reads.read(key.first, key.second);
+
+        reads.execute();
+
+        auto   current = reads.results();
+        size_t written = 0;
+        iolink::utils::exception_parameters::failures_t failures;
+
+        // A parameter that can not be read is written anyway
+        for(const auto &key: order)
+        {
+            const auto &value  = config.value(key.first, key.second);
+            const auto &result = current[key];
+
+            if(result.isOk() && detail::upper(result.value) == value)
+                continue;
+
+            auto [future, callback] = utils::makeFutureCallback<void>();
+
+            try
+            {
+                driver.writeParameterHexAsync(value, key.first, key.second, std::move(callback));
+                future.get();
+                ++written;
+            }
+            catch(...)
+            {
+                failures.emplace_back(key, std::current_exception());
+            }
+        }
+
+        if(!failures.empty())
+            throw iolink::utils::exception_parameters(__func__, std::move(failures));
+
+        return written;
+    }
+}
+
+#endif // IODD_CONFIGURATION_H
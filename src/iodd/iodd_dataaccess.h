@@ -23,9 +23,14 @@
 
 #include "../inc.h"
 #include "iodd_basedriver.h"
+#include "iodd_datatypetraits.h"
+
+#include <mutex>
 
 namespace iolink::iodd
 {
+    enum class AccessMode: uint8_t{READ, WRITE, READ_WRITE};
+
     class BaseAccess
     {
         protected:
@@ -36,10 +41,173 @@ namespace iolink::iodd
             BaseDriver* const m_driver;
     };
 
+    // Subindex access to the items of a RecordT and the elements of an ArrayT parameter
+    namespace detail
+    {
+        template<auto member, typename Record>
+        typename ItemValue<Record, member>::type readItem(const BaseDriver &driver, uint32_t index, const Record &record)
+        {
+            return record.template itemToType<member>(driver.template readParameter<vector_t>(index, Record::template subindex<member>()));
+        }
+
+        template<auto member, typename Record>
+        void readItemAsync(const BaseDriver &driver, uint32_t index, const Record &record, callback_t<typename ItemValue<Record, member>::type> callback)
+        {
+            driver.template readParameterAsync<vector_t>(index, Record::template subindex<member>(), [&record, callback = std::move(callback)](vector_t iodd_value, std::exception_ptr error)
+            {
+                typename ItemValue<Record, member>::type value{};
+
+                if(!error)
+                {
+                    try
+                    {
+                        value = record.template itemToType<member>(iodd_value);
+                    }
+                    catch(...)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+
+                callback(std::move(value), error);
+            });
+        }
+
+        template<auto member, typename Record>
+        void writeItem(const BaseDriver &driver, uint32_t index, const Record &record, const typename ItemValue<Record, member>::type &value)
+        {
+            if(!record.template isValidItem<member>(value))
+                throw iolink::utils::exception_iodd(__func__, iolink::utils::exception_iodd::ErrorCodeType::ERROR_INVALID_VALUE);
+
+            driver.template writeParameter<vector_t>(record.template itemToIoddType<member>(value), index, Record::template subindex<member>());
+        }
+
+        template<auto member, typename Record>
+        void writeItemAsync(const BaseDriver &driver, uint32_t index, const Record &record, const typename ItemValue<Record, member>::type &value, callback_t<void> callback)
+        {
+            if(!record.template isValidItem<member>(value))
+                throw iolink::utils::exception_iodd(__func__, iolink::utils::exception_iodd::ErrorCodeType::ERROR_INVALID_VALUE);
+
+            driver.template writeParameterAsync<vector_t>(record.template itemToIoddType<member>(value), index, Record::template subindex<member>(), std::move(callback));
+        }
+
+        template<typename Array>
+        typename Array::element_t readElement(const BaseDriver &driver, uint32_t index, const Array &array, std::size_t element)
+        {
+            static_assert(Array::has_subindex_access, "The array does not support subindex access");
+
+            return array.elementToType(driver.template readParameter<vector_t>(index, Array::subindex(element)));
+        }
+
+        template<typename Array>
+        void readElementAsync(const BaseDriver &driver, uint32_t index, const Array &array, std::size_t element, callback_t<typename Array::element_t> callback)
+        {
+            static_assert(Array::has_subindex_access, "The array does not support subindex access");
+
+            driver.template readParameterAsync<vector_t>(index, Array::subindex(element), [&array, callback = std::move(callback)](vector_t iodd_value, std::exception_ptr error)
+            {
+                typename Array::element_t value{};
+
+                if(!error)
+                {
+                    try
+                    {
+                        value = array.elementToType(iodd_value);
+                    }
+                    catch(...)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+
+                callback(std::move(value), error);
+            });
+        }
+
+        // All the requests are sent before waiting for the first response. The callback gets the first error
+        template<typename Array>
+        void readElementsAsync(const BaseDriver &driver, uint32_t index, const Array &array, std::size_t first, std::size_t length, callback_t<std::vector<typename Array::element_t>> callback)
+        {
+            if(first > Array::element_count || length > Array::element_count - first)
+                throw iolink::utils::exception_argument(__func__, "Elements are out of the array");
+
+            if(!length)
+                return callback({}, nullptr);
+
+            struct State
+            {
+                std::mutex                                         mutex;
+                std::vector<typename Array::element_t>             values;
+                std::exception_ptr                                 error;
+                std::size_t                                        pending;
+                callback_t<std::vector<typename Array::element_t>> callback;
+            };
+
+            auto state = std::make_shared<State>();
+            state->values.resize(length);
+            state->pending  = length;
+            state->callback = std::move(callback);
+
+            for(std::size_t i = 0; i < length; ++i)
+            {
+                auto done = [state, i](typename Array::element_t value, std::exception_ptr error)
+                {
+                    {
+                        std::lock_guard lock{state->mutex};
+
+                        if(error && !state->error)
+                            state->error = error;
+                        else if(!error)
+                            state->values[i] = std::move(value);
+
+                        if(--state->pending)
+                            return;
+                    }
+
+                    state->callback(std::move(state->values), state->error);
+                };
+
+                try
+                {
+                    readElementAsync(driver, index, array, first + i, done);
+                }
+                catch(...)
+                {
+                    done({}, std::current_exception());
+                }
+            }
+        }
+
+        template<typename Array>
+        void writeElement(const BaseDriver &driver, uint32_t index, const Array &array, std::size_t element, const typename Array::element_t &value)
+        {
+            static_assert(Array::has_subindex_access, "The array does not support subindex access");
+
+            if(!array.isValidElement(value))
+                throw iolink::utils::exception_iodd(__func__, iolink::utils::exception_iodd::ErrorCodeType::ERROR_INVALID_VALUE);
+
+            driver.template writeParameter<vector_t>(array.elementToIoddType(value), index, Array::subindex(element));
+        }
+
+        template<typename Array>
+        void writeElementAsync(const BaseDriver &driver, uint32_t index, const Array &array, std::size_t element, const typename Array::element_t &value, callback_t<void> callback)
+        {
+            static_assert(Array::has_subindex_access, "The array does not support subindex access");
+
+            if(!array.isValidElement(value))
+                throw iolink::utils::exception_iodd(__func__, iolink::utils::exception_iodd::ErrorCodeType::ERROR_INVALID_VALUE);
+
+            driver.template writeParameterAsync<vector_t>(array.elementToIoddType(value), index, Array::subindex(element), std::move(callback));
+        }
+    }
+
     template<uint32_t index, uint32_t sub_index, typename IODDType>
     class Read: protected BaseAccess, public IODDType
     {
         public:
+            static constexpr uint32_t   parameter_index    = index;
+            static constexpr uint32_t   parameter_subindex = sub_index;
+            static constexpr AccessMode access_mode        = AccessMode::READ;
 
             template<typename ...CArgs>
             explicit Read(BaseDriver* const driver, CArgs&& ... cargs):
@@ -49,7 +217,101 @@ namespace iolink::iodd
 
             typename IODDType::type_t read() const
             {
-                return this->toType(BaseAccess::m_driver->getIOLinkDevice()->template read<typename IODDType::iodd_type_t>(index, sub_index));
+                return this->toType(BaseAccess::m_driver->template readParameter<typename IODDType::iodd_type_t>(index, sub_index));
+            }
+
+            // The parameter object must outlive the request
+            void readAsync(callback_t<typename IODDType::type_t> callback) const
+            {
+                BaseAccess::m_driver->template readParameterAsync<typename IODDType::iodd_type_t>(index, sub_index,
+                    [this, callback = std::move(callback)](typename IODDType::iodd_type_t iodd_value, std::exception_ptr error)
+                    {
+                        typename IODDType::type_t value{};
+
+                        if(!error)
+                        {
+                            try
+                            {
+                                value = this->toType(iodd_value);
+                            }
+                            catch(...)
+                            {
+                                error = std::current_exception();
+                            }
+                        }
+
+                        callback(std::move(value), error);
+                    });
+            }
+
+            std::future<typename IODDType::type_t> readAsync() const
+            {
+                auto [future, callback] = utils::makeFutureCallback<typename IODDType::type_t>();
+                readAsync(std::move(callback));
+                return std::move(future);
+            }
+
+            // Reads a single item of a record through its subindex
+            template<auto member>
+            typename detail::ItemValue<IODDType, member>::type readItem() const
+            {
+                return detail::readItem<member, IODDType>(*BaseAccess::m_driver, index, *this);
+            }
+
+            template<auto member>
+            void readItemAsync(callback_t<typename detail::ItemValue<IODDType, member>::type> callback) const
+            {
+                detail::readItemAsync<member, IODDType>(*BaseAccess::m_driver, index, *this, std::move(callback));
+            }
+
+            template<auto member>
+            std::future<typename detail::ItemValue<IODDType, member>::type> readItemAsync() const
+            {
+                auto [future, callback] = utils::makeFutureCallback<typename detail::ItemValue<IODDType, member>::type>();
+                readItemAsync<member>(std::move(callback));
+                return std::move(future);
+            }
+
+            // Reads a single element of an array through its subindex
+            template<typename Array = IODDType>
+            typename Array::element_t readElement(std::size_t element) const
+            {
+                return detail::readElement<Array>(*BaseAccess::m_driver, index, *this, element);
+            }
+
+            template<typename Array = IODDType>
+            void readElementAsync(std::size_t element, callback_t<typename Array::element_t> callback) const
+            {
+                detail::readElementAsync<Array>(*BaseAccess::m_driver, index, *this, element, std::move(callback));
+            }
+
+            template<typename Array = IODDType>
+            std::future<typename Array::element_t> readElementAsync(std::size_t element) const
+            {
+                auto [future, callback] = utils::makeFutureCallback<typename Array::element_t>();
+                readElementAsync<Array>(element, std::move(callback));
+                return std::move(future);
+            }
+
+            // Reads the elements from first on, with one request per element in flight at the same time
+            template<typename Array = IODDType>
+            std::vector<typename Array::element_t> readElements(std::size_t first, std::size_t length) const
+            {
+                return readElementsAsync<Array>(first, length).get();
+            }
+
+            template<typename Array = IODDType>
+            void readElementsAsync(std::size_t first, std::size_t length, callback_t<std::vector<typename Array::element_t>> callback) const
+            {
+                detail::readElementsAsync<Array>(*BaseAccess::m_driver, index, *this, first, length, std::move(callback));
+            }
+
+            template<typename Array = IODDType>
+            std::future<std::vector<typename Array::element_t>> readElementsAsync(std::size_t first, std::size_t length) const
+            {
+                auto [future, callback] = utils::makeFutureCallback<std::vector<typename Array::element_t>>();
+                readElementsAsync<Array>(first, length, std::move(callback));
+                return std::move(future);
             }
     };
 
@@ -57,6 +319,9 @@ namespace iolink::iodd
     class Write: protected BaseAccess, public IODDType
     {
         public:
+            static constexpr uint32_t   parameter_index    = index;
+            static constexpr uint32_t   parameter_subindex = sub_index;
+            static constexpr AccessMode access_mode        = AccessMode::WRITE;
 
             template<typename ...CArgs>
             explicit Write(BaseDriver* const driver, CArgs&& ... cargs):
@@ -69,7 +334,64 @@ namespace iolink::iodd
                 if(!this->isValid(value))
                     throw iolink::utils::exception_iodd(__func__, iolink::utils::exception_iodd::ErrorCodeType::ERROR_INVALID_VALUE);
 
-                BaseAccess::m_driver->getIOLinkDevice()->template write<typename IODDType::iodd_type_t>(this->toIoddType(value), index, sub_index);
+                BaseAccess::m_driver->template writeParameter<typename IODDType::iodd_type_t>(this->toIoddType(value), index, sub_index);
+            }
+
+            void writeAsync(typename IODDType::type_t value, callback_t<void> callback) const
+            {
+                if(!this->isValid(value))
+                    throw iolink::utils::exception_iodd(__func__, iolink::utils::exception_iodd::ErrorCodeType::ERROR_INVALID_VALUE);
+
+                BaseAccess::m_driver->template writeParameterAsync<typename IODDType::iodd_type_t>(this->toIoddType(value), index, sub_index, std::move(callback));
+            }
+
+            std::future<void> writeAsync(typename IODDType::type_t value) const
+            {
+                auto [future, callback] = utils::makeFutureCallback<void>();
+                writeAsync(std::move(value), std::move(callback));
+                return std::move(future);
+            }
+
+            // Writes a single item of a record through its subindex, without reading the rest of the record
+            template<auto member>
+            void writeItem(const typename detail::ItemValue<IODDType, member>::type& value) const
+            {
+                detail::writeItem<member, IODDType>(*BaseAccess::m_driver, index, *this, value);
+            }
+
+            template<auto member>
+            void writeItemAsync(const typename detail::ItemValue<IODDType, member>::type& value, callback_t<void> callback) const
+            {
+                detail::writeItemAsync<member, IODDType>(*BaseAccess::m_driver, index, *this, value, std::move(callback));
+            }
+
+            template<auto member>
+            std::future<void> writeItemAsync(const typename detail::ItemValue<IODDType, member>::type& value) const
+            {
+                auto [future, callback] = utils::makeFutureCallback<void>();
+                writeItemAsync<member>(value, std::move(callback));
+                return std::move(future);
+            }
+
+            // Writes a single element of an array through its subindex, without reading the rest of the array
+            template<typename Array = IODDType>
+            void writeElement(std::size_t element, const typename Array::element_t& value) const
+            {
+                detail::writeElement<Array>(*BaseAccess::m_driver, index, *this, element, value);
+            }
+
+            template<typename Array = IODDType>
+            void writeElementAsync(std::size_t element, const typename Array::element_t& value, callback_t<void> callback) const
+            {
+                detail::writeElementAsync<Array>(*BaseAccess::m_driver, index, *this, element, value, std::move(callback));
+            }
+
+            template<typename Array = IODDType>
+            std::future<void> writeElementAsync(std::size_t element, const typename Array::element_t& value) const
+            {
+                auto [future, callback] = utils::makeFutureCallback<void>();
+                writeElementAsync<Array>(element, value, std::move(callback));
+                return std::move(future);
             }
     };
 
@@ -78,6 +400,9 @@ namespace iolink::iodd
     class ReadWrite: protected BaseAccess, public IODDType
     {
         public:
+            static constexpr uint32_t   parameter_index    = index;
+            static constexpr uint32_t   parameter_subindex = sub_index;
+            static constexpr AccessMode access_mode        = AccessMode::READ_WRITE;
 
             template<typename ...CArgs>
             explicit ReadWrite(BaseDriver* const driver, CArgs&& ... cargs):
@@ -88,7 +413,101 @@ namespace iolink::iodd
 
             typename IODDType::type_t read() const
             {
-                return this->toType(BaseAccess::m_driver->getIOLinkDevice()->template read<typename IODDType::iodd_type_t>(index, sub_index));
+                return this->toType(BaseAccess::m_driver->template readParameter<typename IODDType::iodd_type_t>(index, sub_index));
+            }
+
+            // The parameter object must outlive the request
+            void readAsync(callback_t<typename IODDType::type_t> callback) const
+            {
+                BaseAccess::m_driver->template readParameterAsync<typename IODDType::iodd_type_t>(index, sub_index,
+                    [this, callback = std::move(callback)](typename IODDType::iodd_type_t iodd_value, std::exception_ptr error)
+                    {
+                        typename IODDType::type_t value{};
+
+                        if(!error)
+                        {
+                            try
+                            {
+                                value = this->toType(iodd_value);
+                            }
+                            catch(...)
+                            {
+                                error = std::current_exception();
+                            }
+                        }
+
+                        callback(std::move(value), error);
+                    });
+            }
+
+            std::future<typename IODDType::type_t> readAsync() const
+            {
+                auto [future, callback] = utils::makeFutureCallback<typename IODDType::type_t>();
+                readAsync(std::move(callback));
+                return std::move(future);
+            }
+
+            // Reads a single item of a record through its subindex
+            template<auto member>
+            typename detail::ItemValue<IODDType, member>::type readItem() const
+            {
+                return detail::readItem<member, IODDType>(*BaseAccess::m_driver, index, *this);
+            }
+
+            template<auto member>
+            void readItemAsync(callback_t<typename detail::ItemValue<IODDType, member>::type> callback) const
+            {
+                detail::readItemAsync<member, IODDType>(*BaseAccess::m_driver, index, *this, std::move(callback));
+            }
+
+            template<auto member>
+            std::future<typename detail::ItemValue<IODDType, member>::type> readItemAsync() const
+            {
+                auto [future, callback] = utils::makeFutureCallback<typename detail::ItemValue<IODDType, member>::type>();
+                readItemAsync<member>(std::move(callback));
+                return std::move(future);
+            }
+
+            // Reads a single element of an array through its subindex
+            template<typename Array = IODDType>
+            typename Array::element_t readElement(std::size_t element) const
+            {
+                return detail::readElement<Array>(*BaseAccess::m_driver, index, *this, element);
+            }
+
+            template<typename Array = IODDType>
+            void readElementAsync(std::size_t element, callback_t<typename Array::element_t> callback) const
+            {
+                detail::readElementAsync<Array>(*BaseAccess::m_driver, index, *this, element, std::move(callback));
+            }
+
+            template<typename Array = IODDType>
+            std::future<typename Array::element_t> readElementAsync(std::size_t element) const
+            {
+                auto [future, callback] = utils::makeFutureCallback<typename Array::element_t>();
+                readElementAsync<Array>(element, std::move(callback));
+                return std::move(future);
+            }
+
+            // Reads the elements from first on, with one request per element in flight at the same time
+            template<typename Array = IODDType>
+            std::vector<typename Array::element_t> readElements(std::size_t first, std::size_t length) const
+            {
+                return readElementsAsync<Array>(first, length).get();
+            }
+
+            template<typename Array = IODDType>
+            void readElementsAsync(std::size_t first, std::size_t length, callback_t<std::vector<typename Array::element_t>> callback) const
+            {
+                detail::readElementsAsync<Array>(*BaseAccess::m_driver, index, *this, first, length, std::move(callback));
+            }
+
+            template<typename Array = IODDType>
+            std::future<std::vector<typename Array::element_t>> readElementsAsync(std::size_t first, std::size_t length) const
+            {
+                auto [future, callback] = utils::makeFutureCallback<std::vector<typename Array::element_t>>();
+                readElementsAsync<Array>(first, length, std::move(callback));
+                return std::move(future);
             }
 
             void write(typename IODDType::type_t value) const
@@ -96,7 +515,64 @@ namespace iolink::iodd
                 if(!this->isValid(value))
                     throw iolink::utils::exception_iodd(__func__, iolink::utils::exception_iodd::ErrorCodeType::ERROR_INVALID_VALUE);
 
-                BaseAccess::m_driver->getIOLinkDevice()->template write<typename IODDType::iodd_type_t>(this->toIoddType(value), index, sub_index);
+                BaseAccess::m_driver->template writeParameter<typename IODDType::iodd_type_t>(this->toIoddType(value), index, sub_index);
+            }
+
+            void writeAsync(typename IODDType::type_t value, callback_t<void> callback) const
+            {
+                if(!this->isValid(value))
+                    throw iolink::utils::exception_iodd(__func__, iolink::utils::exception_iodd::ErrorCodeType::ERROR_INVALID_VALUE);
+
+                BaseAccess::m_driver->template writeParameterAsync<typename IODDType::iodd_type_t>(this->toIoddType(value), index, sub_index, std::move(callback));
+            }
+
+            std::future<void> writeAsync(typename IODDType::type_t value) const
+            {
+                auto [future, callback] = utils::makeFutureCallback<void>();
+                writeAsync(std::move(value), std::move(callback));
+                return std::move(future);
+            }
+
+            // Writes a single item of a record through its subindex, without reading the rest of the record
+            template<auto member>
+            void writeItem(const typename detail::ItemValue<IODDType, member>::type& value) const
+            {
+                detail::writeItem<member, IODDType>(*BaseAccess::m_driver, index, *this, value);
+            }
+
+            template<auto member>
+            void writeItemAsync(const typename detail::ItemValue<IODDType, member>::type& value, callback_t<void> callback) const
+            {
+                detail::writeItemAsync<member, IODDType>(*BaseAccess::m_driver, index, *this, value, std::move(callback));
+            }
+
+            template<auto member>
+            std::future<void> writeItemAsync(const typename detail::ItemValue<IODDType, member>::type& value) const
+            {
+                auto [future, callback] = utils::makeFutureCallback<void>();
+                writeItemAsync<member>(value, std::move(callback));
+                return std::move(future);
+            }
+
+            // Writes a single element of an array through its subindex, without reading the rest of the array
+            template<typename Array = IODDType>
+            void writeElement(std::size_t element, const typename Array::element_t& value) const
+            {
+                detail::writeElement<Array>(*BaseAccess::m_driver, index, *this, element, value);
+            }
+
+            template<typename Array = IODDType>
+            void writeElementAsync(std::size_t element, const typename Array::element_t& value, callback_t<void> callback) const
+            {
+                detail::writeElementAsync<Array>(*BaseAccess::m_driver, index, *this, element, value, std::move(callback));
+            }
+
+            template<typename Array = IODDType>
+            std::future<void> writeElementAsync(std::size_t element, const typename Array::element_t& value) const
+            {
+                auto [future, callback] = utils::makeFutureCallback<void>();
+                writeElementAsync<Array>(element, value, std::move(callback));
+                return std::move(future);
             }
     };
 }
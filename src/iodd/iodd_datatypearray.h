@@ -21,21 +21,32 @@
 #ifndef IODD_DATATYPEARRAY_H
 #define IODD_DATATYPEARRAY_H
 
+#include "../bitstream.h"
 #include "../inc.h"
 #include "../exception.h"
+#include "iodd_datatypetraits.h"
 
-// TODO: implement subindex_access
 // TODO: template must not accept itself as template argument of IODDType
 
 namespace iolink::iodd
 {
-
+    /*
+     * Array of simple types. When the device supports subindex access, the elements can also be read and written one
+     * by one with readElement(), readElements() and writeElement() of the parameter. Element i has subindex i + 1.
+     */
     template<typename IODDType, std::size_t count, bool subindex_access = false>
     class ArrayT
     {
         public:
             using type_t = std::array<typename IODDType::type_t, count>;
             using iodd_type_t = vector_t;
+            using element_t = typename IODDType::type_t;
+
+            static constexpr std::size_t element_count       = count;
+            static constexpr bool        has_subindex_access = subindex_access;
+
+            static_assert(count > 0, "Array must have at least one element");
+            static_assert(!subindex_access || count < 256, "Subindex access is limited to 255 elements");
 
             ArrayT(const ArrayT&) =delete;
             ArrayT(ArrayT&&) =delete;
@@ -58,20 +69,35 @@ namespace iolink::iodd
                 return true;
             }
 
-            type_t toType(iodd_type_t iodd_vector) const
+            // The elements are right aligned in the data. The first element is the most significant one
+            type_t toType(const iodd_type_t& iodd_vector) const
             {
+                const std::size_t length = count * detail::bitLength(m_element);
+
+                if(iodd_vector.size() * 8 < length)
+                    throw iolink::utils::exception_argument(__func__, "Array data is shorter than " + std::to_string(count) + " elements");
+
+                utils::BitReader reader{iodd_vector.data(), iodd_vector.size()};
+                reader.seek(reader.size() - length);
+
                 auto array = type_t{};
-                for(int i = count - 1; i >= 0; --i)
-                        array[i] = m_element.unpackFromVector(iodd_vector);
+                for(auto& el: array)
+                    el = m_element.unpack(reader);
 
                 return array;
             }
 
-            iodd_type_t toIoddType(type_t array) const
+            iodd_type_t toIoddType(const type_t& array) const
             {
-                auto iodd_vector = iodd_type_t{};
-                for(int i = count - 1; i >= 0; --i)
-                        m_element.packToVector(iodd_vector, array[i]);
+                const std::size_t length = count * detail::bitLength(m_element);
+
+                auto iodd_vector = iodd_type_t((length + 7) / 8, 0);
+
+                utils::BitWriter writer{iodd_vector.data(), iodd_vector.size()};
+                writer.seek(writer.size() - length);
+
+                for(const auto& el: array)
+                    m_element.pack(writer, el);
 
                 return iodd_vector;
             }
@@ -81,6 +107,46 @@ namespace iolink::iodd
                 return type_t{};
             }
 
+            static uint8_t subindex(std::size_t element)
+            {
+                if(element >= count)
+                    throw iolink::utils::exception_argument(__func__, "Element " + std::to_string(element) + " is out of the array");
+
+                return static_cast<uint8_t>(element + 1);
+            }
+
+            bool isValidElement(const element_t& value) const
+            {
+                return m_element.isValid(value);
+            }
+
+            // Decodes the data of a single element read through its subindex. The value is right aligned in the bytes
+            element_t elementToType(const iodd_type_t& iodd_vector) const
+            {
+                const auto length = detail::bitLength(m_element);
+
+                if(iodd_vector.size() * 8 < length)
+                    throw iolink::utils::exception_argument(__func__, "Element data is shorter than the element");
+
+                utils::BitReader reader{iodd_vector.data(), iodd_vector.size()};
+                reader.seek(reader.size() - length);
+
+                return m_element.unpack(reader);
+            }
+
+            iodd_type_t elementToIoddType(const element_t& value) const
+            {
+                const auto length = detail::bitLength(m_element);
+
+                auto iodd_vector = iodd_type_t((length + 7) / 8, 0);
+
+                utils::BitWriter writer{iodd_vector.data(), iodd_vector.size()};
+                writer.seek(writer.size() - length);
+                m_element.pack(writer, value);
+
+                return iodd_vector;
+            }
+
         private:
             IODDType m_element;
     };
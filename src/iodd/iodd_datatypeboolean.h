@@ -21,8 +21,10 @@
 #ifndef IODD_DATATYPEBOOLEAN_H
 #define IODD_DATATYPEBOOLEAN_H
 
+#include "../bitstream.h"
 #include "../inc.h"
 #include "../exception.h"
+#include "iodd_datatypetraits.h"
 
 namespace iolink::iodd
 {
@@ -32,6 +34,8 @@ namespace iolink::iodd
             using type_t = bool;
             using iodd_type_t = bool;
 
+            static constexpr uint8_t bit_length = 1;
+
             BooleanT(const BooleanT&) =delete;
             BooleanT(BooleanT&&) =delete;
             BooleanT& operator =(const BooleanT&) =delete;
@@ -58,18 +62,25 @@ namespace iolink::iodd
                 return value;
             }
 
+            type_t unpack(utils::BitReader& reader) const
+            {
+                return reader.read(bit_length) != 0;
+            }
+
+            void pack(utils::BitWriter& writer, const type_t& value) const
+            {
+                writer.write(value, bit_length);
+            }
+
+            // Replaced by unpack() and pack(), kept for compatibility. Takes the value from the end of the vector
             type_t unpackFromVector(vector_t& vector) const
             {
-                type_t value = uint8_t(vector.back()) & 0x01;
-
-                uint8_t bits_transfer = 0;  // Bits from the previous byte
-                for(auto& el: vector)
-                {
-                    uint8_t bits_poped = el & 0x01;  // Save the bit to be shifted right
-                    el = (el >> 1) | (bits_transfer << 7);  // Shift right the byte and apply the bit shifted from the previous byte
-                    bits_transfer = bits_poped;  // Save the right shifted bit
-                }
-                return value;
+                return detail::unpackFromVector(*this, vector);
+            }
+
+            void packToVector(vector_t& vector, const type_t& value) const
+            {
+                detail::packToVector(*this, vector, value);
             }
 
             string_t description(type_t value) const
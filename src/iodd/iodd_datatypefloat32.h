@@ -21,10 +21,12 @@
 #ifndef IODD_DATATYPEFLOAT32_H
 #define IODD_DATATYPEFLOAT32_H
 
+#include "../bitstream.h"
 #include "../inc.h"
 #include "../exception.h"
+#include "iodd_datatypetraits.h"
 
-// TODO: implement packToVector()
+#include <cstring>
 
 namespace iolink::iodd
 {
@@ -34,6 +36,8 @@ namespace iolink::iodd
             using type_t = float;
             using iodd_type_t = float;
 
+            static constexpr uint8_t bit_length = 32;
+
             Float32T(const Float32T&) =delete;
             Float32T(Float32T&&) =delete;
             Float32T& operator =(const Float32T&) =delete;
@@ -71,17 +75,36 @@ namespace iolink::iodd
                 return value;
             }
 
-            type_t unpackFromVector(vector_t& vector) const
+            // The bits of the IEEE 754 single precision number, not its value converted to an integer
+            type_t unpack(utils::BitReader& reader) const
             {
-                uint32_t value = 0;
-                for(std::size_t i = 0; i < 4; ++i)
-                {
-                    value |= uint32_t(vector.back()) << (i * 8);
-                    vector.pop_back();
-                }
+                const auto bits = static_cast<uint32_t>(reader.read(bit_length));
+
+                type_t value = 0;
+                std::memcpy(&value, &bits, sizeof(value));
+
                 return value;
             }
 
+            void pack(utils::BitWriter& writer, const type_t& value) const
+            {
+                uint32_t bits = 0;
+                std::memcpy(&bits, &value, sizeof(bits));
+
+                writer.write(bits, bit_length);
+            }
+
+            // Replaced by unpack() and pack(), kept for compatibility. Takes the value from the end of the vector
+            type_t unpackFromVector(vector_t& vector) const
+            {
+                return detail::unpackFromVector(*this, vector);
+            }
+
+            void packToVector(vector_t& vector, const type_t& value) const
+            {
+                detail::packToVector(*this, vector, value);
+            }
+
             string_t description(type_t value) const
             {
                 if(m_single_values.find(value) == end(m_single_values))
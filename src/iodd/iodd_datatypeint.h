@@ -21,19 +21,19 @@
 #ifndef IODD_DATATYPEINT_H
 #define IODD_DATATYPEINT_H
 
+#include "../bitstream.h"
 #include "../utils.h"
 #include "../inc.h"
 #include "../exception.h"
-
-// TODO: implement packToVector()
+#include "iodd_datatypetraits.h"
 
 namespace iolink::iodd
 {
-    template <uint8_t bit_length,
-              typename Type = std::conditional_t<(bit_length >= 2 && bit_length <= 8), int8_t,
-                                                 std::conditional_t<(bit_length >= 9 && bit_length <= 16), int16_t,
-                                                                    std::conditional_t<(bit_length >= 17 && bit_length <= 32), int32_t,
-                                                                                       typename std::enable_if<(bit_length >= 33 && bit_length <= 64), int64_t>
+    template <uint8_t length,
+              typename Type = std::conditional_t<(length >= 2 && length <= 8), int8_t,
+                                                 std::conditional_t<(length >= 9 && length <= 16), int16_t,
+                                                                    std::conditional_t<(length >= 17 && length <= 32), int32_t,
+                                                                                       std::conditional_t<(length >= 33 && length <= 64), int64_t, void>
                                                                                        >
                                                                     >
                                                  >
@@ -44,6 +44,8 @@ namespace iolink::iodd
             using type_t = Type;
             using iodd_type_t = Type;
 
+            static constexpr uint8_t bit_length = length;
+
             IntegerT(const IntegerT&) =delete;
             IntegerT(IntegerT&&) =delete;
             IntegerT& operator =(const IntegerT&) =delete;
@@ -61,11 +63,8 @@ namespace iolink::iodd
                 }
                 else
                 {
-                    for(int i = 0; i < bit_length; ++i)
-                        m_max = (m_max << 1) | 0x01;
-
-                    m_min = -m_max;
-                    --m_max;
+                    m_min = lowest();
+                    m_max = highest();
 
                     if(max > m_max )
                         throw iolink::utils::exception_argument(__func__, "Max value can't be higher than "+std::to_string(m_max));
@@ -82,12 +81,12 @@ namespace iolink::iodd
             }
 
             explicit IntegerT(type_t max, map_t<type_t> single_values = map_t<type_t>{}):
-                IntegerT{std::numeric_limits<type_t>::min(), max, single_values}
+                IntegerT{lowest(), max, single_values}
             {
             }
 
             explicit IntegerT():
-                IntegerT{std::numeric_limits<type_t>::min(), std::numeric_limits<type_t>::max()}
+                IntegerT{lowest(), highest()}
             {
             }
 
@@ -112,33 +111,27 @@ namespace iolink::iodd
                 return value;
             }
 
-            type_t unpackFromVector(vector_t& vector) const
+            type_t unpack(utils::BitReader& reader) const
             {
-                constexpr auto bytes = bit_length / 8;
-                constexpr auto bits  = bit_length % 8;
-
-                type_t value = 0;
-                for(std::size_t i = 0; i < bytes; ++i)
-                {
-                    value |= type_t(vector.back()) << (i * 8);
-                    vector.pop_back();
-                }
+                // Sign extension of the most significant bit
+                constexpr unsigned shift = 64 - bit_length;
+                return static_cast<type_t>(static_cast<int64_t>(reader.read(bit_length) << shift) >> shift);
+            }
 
-                if(bits)
-                {
-                    auto mask = utils::createBitMask<uint8_t, bits>();
+            void pack(utils::BitWriter& writer, const type_t& value) const
+            {
+                writer.write(static_cast<uint64_t>(value), bit_length);
+            }
 
-                    value |= type_t(vector.back() & mask) << (bytes * 8);
+            // Replaced by unpack() and pack(), kept for compatibility. Takes the value from the end of the vector
+            type_t unpackFromVector(vector_t& vector) const
+            {
+                return detail::unpackFromVector(*this, vector);
+            }
 
-                    uint8_t bits_transfer = 0;  // Bits from the previous byte
-                    for(auto& el: vector)
-                    {
-                        uint8_t bits_poped = el & mask ;  // Bits to be shifted right
-                        el = (el >> bits) | (bits_transfer << ( 8 - bits));  // Shift right the bits and apply the bits shifted from the previous byte
-                        bits_transfer = bits_poped;  // Save the right shifted bits
-                    }
-                }
-                return value;
+            void packToVector(vector_t& vector, const type_t& value) const
+            {
+                detail::packToVector(*this, vector, value);
             }
 
             string_t description(type_t value) const
@@ -149,6 +142,18 @@ namespace iolink::iodd
                 return m_single_values.at(value);
             }
 
+        private:
+            // Range of a two's complement number of bit_length bits
+            static constexpr type_t lowest()
+            {
+                return bit_length == sizeof(type_t) * 8 ? std::numeric_limits<type_t>::min() : static_cast<type_t>(-(int64_t{1} << (bit_length - 1)));
+            }
+
+            static constexpr type_t highest()
+            {
+                return bit_length == sizeof(type_t) * 8 ? std::numeric_limits<type_t>::max() : static_cast<type_t>((int64_t{1} << (bit_length - 1)) - 1);
+            }
+
         private:
             type_t m_min = 0;
             type_t m_max = 0;
@@ -21,10 +21,10 @@
 #ifndef IODD_DATATYPEOCTETSTRING_H
 #define IODD_DATATYPEOCTETSTRING_H
 
-#include "libiolink/inc.h"
-#include "libiolink/exception.h"
-
-// TODO: implement packToVector() only when the length is fixed
+#include "../bitstream.h"
+#include "../inc.h"
+#include "../exception.h"
+#include "iodd_datatypetraits.h"
 
 namespace iolink::iodd
 {
@@ -83,22 +83,42 @@ namespace iolink::iodd
                 return value;
             }
 
-            type_t unpackFromVector(vector_t& vector) const
+            // Only octet strings of fixed length can be part of arrays and records
+            std::size_t bitLength() const
             {
                 if(m_min_len != m_max_len)
-                    throw iolink::utils::exception_logic(__func__, "Only fixed value strings can be unpacket from ArrayT");
+                    throw iolink::utils::exception_logic(__func__, "Only fixed length octet strings can be packed");
 
-                type_t value(m_max_len);
+                return std::size_t{m_max_len} * 8;
+            }
 
-                for(std::size_t i = 0; i < m_max_len; ++i)
-                {
-                    value[i] = vector.back();
-                    vector.pop_back();
-                }
+            type_t unpack(utils::BitReader& reader) const
+            {
+                type_t value(bitLength() / 8);
+                reader.readBytes(value.data(), value.size());
 
                 return value;
             }
 
+            void pack(utils::BitWriter& writer, const type_t& value) const
+            {
+                if(value.size() * 8 != bitLength())
+                    throw iolink::utils::exception_argument(__func__, "Octet string size does not match its fixed length");
+
+                writer.writeBytes(value.data(), value.size());
+            }
+
+            // Replaced by unpack() and pack(), kept for compatibility. Takes the value from the end of the vector
+            type_t unpackFromVector(vector_t& vector) const
+            {
+                return detail::unpackFromVector(*this, vector);
+            }
+
+            void packToVector(vector_t& vector, const type_t& value) const
+            {
+                detail::packToVector(*this, vector, value);
+            }
+
         private:
             const uint32_t m_min_len = std::numeric_limits<uint32_t>::min();
             const uint32_t m_max_len = std::numeric_limits<uint32_t>::max();
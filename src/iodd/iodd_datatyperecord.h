@@ -21,4 +21,272 @@
 #ifndef IODD_RECORD_H
 #define IODD_RECORD_H
 
+#include "../bitstream.h"
+#include "../inc.h"
+#include "../exception.h"
+#include "iodd_datatypetraits.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace iolink::iodd
+{
+    namespace detail
+    {
+        // Position of the item of the member in the list of items
+        template<auto member, std::size_t i, typename ... Items>
+        constexpr std::size_t recordItemPosition()
+        {
+            static_assert(i < sizeof...(Items), "The member is not an item of the record");
+
+            if constexpr(i < sizeof...(Items))
+            {
+                if constexpr(isSameMember<std::tuple_element_t<i, std::tuple<Items...>>::pointer, member>())
+                    return i;
+                else
+                    return recordItemPosition<member, i + 1, Items...>();
+            }
+            else
+                return 0;
+        }
+
+        template<typename T>
+        struct IsTuple: std::false_type {};
+
+        template<typename ... T>
+        struct IsTuple<std::tuple<T...>>: std::true_type {};
+
+        // Item type constructed in place from a single argument or from a tuple of arguments
+        template<typename IODDType>
+        struct RecordItemType
+        {
+            RecordItemType() =default;
+
+            template<typename Arg, typename = std::enable_if_t<!IsTuple<std::decay_t<Arg>>::value>>
+            explicit RecordItemType(Arg&& arg):
+                type{std::forward<Arg>(arg)}
+            {}
+
+            template<typename ... Args>
+            explicit RecordItemType(const std::tuple<Args...>& args):
+                RecordItemType{args, std::index_sequence_for<Args...>{}}
+            {}
+
+            template<typename ... Args, std::size_t ... i>
+            RecordItemType(const std::tuple<Args...>& args, std::index_sequence<i ...>):
+                type{std::get<i>(args) ...}
+            {}
+
+            IODDType type;
+        };
+
+        template<uint8_t ... subindices>
+        constexpr bool areUnique()
+        {
+            constexpr uint8_t values[] = {subindices ...};
+
+            for(std::size_t i = 0; i < sizeof...(subindices); ++i)
+                for(std::size_t j = i + 1; j < sizeof...(subindices); ++j)
+                    if(values[i] == values[j])
+                        return false;
+
+            return true;
+        }
+    }
+
+    /*
+     * Item of a record. The bit offset follows the IO-Link convention: offset 0 is the least significant bit of the last
+     * byte of the record. The subindex addresses the item on its own.
+     */
+    template<uint8_t subindex, auto member, uint16_t offset, typename IODDType>
+    struct RecordItem
+    {
+        using struct_t    = typename detail::MemberPointer<decltype(member)>::struct_t;
+        using value_t     = typename detail::MemberPointer<decltype(member)>::value_t;
+        using iodd_type_t = IODDType;
+
+        static constexpr uint8_t  sub_index  = subindex;
+        static constexpr auto     pointer    = member;
+        static constexpr uint16_t bit_offset = offset;
+
+        static_assert(subindex > 0, "Subindex 0 addresses the whole record");
+        static_assert(std::is_same_v<value_t, typename IODDType::type_t>, "The member must have the type of the item");
+    };
+
+    /*
+     * Record decoded into and encoded from a plain struct. The items are placed by their bit offsets, so the whole
+     * record is read with one request on subindex 0. A single item can also be read or written through its subindex
+     * with readItem() and writeItem() of the parameter.
+     *
+     * Every item type is default constructed, unless the record is constructed with one argument per item: the argument
+     * of the item type, e.g. the maximum length of a string, or a std::tuple of its arguments. An empty tuple keeps the
+     * default.
+     *
+     * Example:
+     *
+     *     struct Config
+     *     {
+     *         uint16_t delay  = 0;
+     *         bool     invert = false;
+     *     };
+     *
+     *     using ConfigT = RecordT<Config,
+     *                             RecordItem<1, &Config::delay,  8, UIntegerT<16>>,
+     *                             RecordItem<2, &Config::invert, 0, BooleanT>>;
+     *
+     *     ReadWrite<80, 0, ConfigT> config{this};
+     *
+     *     Config value = config.read();
+     *     config.writeItem<&Config::invert>(true);
+     */
+    template<typename Struct, typename ... Items>
+    class RecordT
+    {
+        public:
+            using type_t = Struct;
+            using iodd_type_t = vector_t;
+
+            template<auto member>
+            using item_t = std::tuple_element_t<detail::recordItemPosition<member, 0, Items...>(), std::tuple<Items...>>;
+
+            static_assert(sizeof...(Items) > 0, "Record must have at least one item");
+            static_assert((std::is_same_v<typename Items::struct_t, Struct> && ...), "All the items must be members of the struct");
+            static_assert(detail::areUnique<Items::sub_index ...>(), "Items must have different subindices");
+
+            RecordT(const RecordT&) =delete;
+            RecordT(RecordT&&) =delete;
+            RecordT& operator =(const RecordT&) =delete;
+            RecordT& operator =(RecordT&&) =delete;
+            ~RecordT() = default;
+
+            explicit RecordT() =default;
+
+            template<typename ...CArgs, typename = std::enable_if_t<sizeof...(CArgs) == sizeof...(Items)>>
+            explicit RecordT(CArgs&& ... cargs):
+                m_items{std::forward<CArgs>(cargs) ...}
+            {
+            }
+
+            bool isValid(const type_t& value) const
+            {
+                return isValid(value, std::index_sequence_for<Items...>{});
+            }
+
+            // Length of the record, up to the most significant bit of the last item
+            std::size_t bitLength() const
+            {
+                return bitLength(std::index_sequence_for<Items...>{});
+            }
+
+            type_t toType(const iodd_type_t& iodd_vector) const
+            {
+                if(iodd_vector.size() * 8 < bitLength())
+                    throw iolink::utils::exception_argument(__func__, "Record data is shorter than the record");
+
+                utils::BitReader reader{iodd_vector.data(), iodd_vector.size()};
+
+                type_t value{};
+                unpack(reader, value, std::index_sequence_for<Items...>{});
+
+                return value;
+            }
+
+            // The bits that are not part of any item are zero
+            iodd_type_t toIoddType(const type_t& value) const
+            {
+                auto iodd_vector = iodd_type_t((bitLength() + 7) / 8, 0);
+
+                utils::BitWriter writer{iodd_vector.data(), iodd_vector.size()};
+                pack(writer, value, std::index_sequence_for<Items...>{});
+
+                return iodd_vector;
+            }
+
+            type_t makeEmpty()
+            {
+                return type_t{};
+            }
+
+            template<auto member>
+            static constexpr uint8_t subindex()
+            {
+                return item_t<member>::sub_index;
+            }
+
+            template<auto member>
+            bool isValidItem(const typename item_t<member>::value_t& value) const
+            {
+                return std::get<position<member>()>(m_items).type.isValid(value);
+            }
+
+            // Decodes the data of a single item read through its subindex. The value is right aligned in the bytes
+            template<auto member>
+            typename item_t<member>::value_t itemToType(const iodd_type_t& iodd_vector) const
+            {
+                const auto &type  = std::get<position<member>()>(m_items).type;
+                const auto length = detail::bitLength(type);
+
+                if(iodd_vector.size() * 8 < length)
+                    throw iolink::utils::exception_argument(__func__, "Item data is shorter than the item");
+
+                utils::BitReader reader{iodd_vector.data(), iodd_vector.size()};
+                reader.seek(reader.size() - length);
+
+                return type.unpack(reader);
+            }
+
+            template<auto member>
+            iodd_type_t itemToIoddType(const typename item_t<member>::value_t& value) const
+            {
+                const auto &type  = std::get<position<member>()>(m_items).type;
+                const auto length = detail::bitLength(type);
+
+                auto iodd_vector = iodd_type_t((length + 7) / 8, 0);
+
+                utils::BitWriter writer{iodd_vector.data(), iodd_vector.size()};
+                writer.seek(writer.size() - length);
+                type.pack(writer, value);
+
+                return iodd_vector;
+            }
+
+        private:
+            template<auto member>
+            static constexpr std::size_t position()
+            {
+                return detail::recordItemPosition<member, 0, Items...>();
+            }
+
+            template<std::size_t ... i>
+            bool isValid(const type_t& value, std::index_sequence<i ...>) const
+            {
+                return (std::get<i>(m_items).type.isValid(value.*Items::pointer) && ...);
+            }
+
+            template<std::size_t ... i>
+            std::size_t bitLength(std::index_sequence<i ...>) const
+            {
+                return std::max({std::size_t{Items::bit_offset} + detail::bitLength(std::get<i>(m_items).type) ...});
+            }
+
+            // Every item is read from its offset, so the order of the items does not matter
+            template<std::size_t ... i>
+            void unpack(utils::BitReader& reader, type_t& value, std::index_sequence<i ...>) const
+            {
+                ((reader.seek(reader.size() - Items::bit_offset - detail::bitLength(std::get<i>(m_items).type)),
+                  value.*Items::pointer = std::get<i>(m_items).type.unpack(reader)), ...);
+            }
+
+            template<std::size_t ... i>
+            void pack(utils::BitWriter& writer, const type_t& value, std::index_sequence<i ...>) const
+            {
+                ((writer.seek(writer.size() - Items::bit_offset - detail::bitLength(std::get<i>(m_items).type)),
+                  std::get<i>(m_items).type.pack(writer, value.*Items::pointer)), ...);
+            }
+
+        private:
+            std::tuple<detail::RecordItemType<typename Items::iodd_type_t> ...> m_items;
+    };
+}
+
 #endif // IODD_RECORD_H
@@ -21,11 +21,10 @@
 #ifndef IODD_DATATYPESTRING_H
 #define IODD_DATATYPESTRING_H
 
+#include "../bitstream.h"
 #include "../inc.h"
 #include "../exception.h"
-
-// TODO: implement unpackFromVector() only when the length is fixed
-// TODO: implement packToVector() only when the length is fixed
+#include "iodd_datatypetraits.h"
 
 namespace iolink::iodd
 {
@@ -180,6 +179,50 @@ namespace iolink::iodd
                 return new_string;
             }
 
+            // Inside arrays and records the string always takes its maximum length
+            std::size_t bitLength() const
+            {
+                if(m_max_len == std::numeric_limits<uint32_t>::max())
+                    throw iolink::utils::exception_logic(__func__, "Only strings with a maximum length can be packed");
+
+                return std::size_t{m_max_len} * 8;
+            }
+
+            // The padding after a shorter string is dropped
+            type_t unpack(utils::BitReader& reader) const
+            {
+                type_t value(bitLength() / 8, '\0');
+                reader.readBytes(reinterpret_cast<uint8_t*>(value.data()), value.size());
+                value.resize(std::min(value.find('\0'), value.size()));
+
+                return value;
+            }
+
+            // A shorter string is padded with zeros
+            void pack(utils::BitWriter& writer, const type_t& value) const
+            {
+                const auto length = bitLength() / 8;
+
+                if(value.size() > length)
+                    throw iolink::utils::exception_argument(__func__, "String size greater than maximum value");
+
+                writer.writeBytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+
+                for(auto i = value.size(); i < length; ++i)
+                    writer.write(0, 8);
+            }
+
+            // Replaced by unpack() and pack(), kept for compatibility. Takes the value from the end of the vector
+            type_t unpackFromVector(vector_t& vector) const
+            {
+                return detail::unpackFromVector(*this, vector);
+            }
+
+            void packToVector(vector_t& vector, const type_t& value) const
+            {
+                detail::packToVector(*this, vector, value);
+            }
+
         private:
             const uint32_t m_min_len      = std::numeric_limits<uint32_t>::min();
             const uint32_t m_max_len      = std::numeric_limits<uint32_t>::max();
@@ -21,11 +21,10 @@
 #ifndef IODD_DATATYPETIME_H
 #define IODD_DATATYPETIME_H
 
+#include "../bitstream.h"
 #include "../inc.h"
 #include "../exception.h"
-
-// TODO: implement unpackFromVector()
-// TODO: implement packToVector()
+#include "iodd_datatypetraits.h"
 
 namespace iolink::iodd
 {
@@ -227,6 +226,8 @@ namespace iolink::iodd
             using type_t = Time;
             using iodd_type_t = string_t;
 
+            static constexpr uint8_t bit_length = 64;
+
             TimeT(const TimeT&) =delete;
             TimeT(TimeT&&) =delete;
             TimeT& operator =(const TimeT&) =delete;
@@ -259,6 +260,75 @@ namespace iolink::iodd
             {
                 return value.toString();
             }
+
+            /*
+             * The binary form is the NTP timestamp: seconds since 1900-01-01 and the fraction of the second in units
+             * of 2^-32 s. Seconds with the most significant bit cleared count from 2036-02-07T06:28:16, so the range
+             * is 1968 to 2104.
+             */
+            type_t unpack(utils::BitReader& reader) const
+            {
+                auto seconds        = reader.read(32);
+                const auto fraction = reader.read(32);
+
+                if(seconds < era_start)
+                    seconds += uint64_t{1} << 32;
+
+                const auto days = static_cast<int64_t>(seconds / 86400) - days_1900_to_1970;
+                const auto time = seconds % 86400;
+
+                // Civil date from the days since 1970-01-01 (H. Hinnant)
+                const int64_t  z   = days + 719468;
+                const int64_t  era = (z >= 0 ? z : z - 146096) / 146097;
+                const uint64_t doe = static_cast<uint64_t>(z - era * 146097);
+                const uint64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+                const uint64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+                const uint64_t mp  = (5 * doy + 2) / 153;
+                const uint64_t day = doy - (153 * mp + 2) / 5 + 1;
+                const uint64_t mon = mp < 10 ? mp + 3 : mp - 9;
+                const int64_t  yr  = static_cast<int64_t>(yoe) + era * 400 + (mon <= 2);
+
+                return type_t{static_cast<Time::year_t>(yr), static_cast<Time::month_t>(mon), static_cast<Time::day_t>(day),
+                              static_cast<Time::hour_t>(time / 3600), static_cast<Time::minute_t>(time % 3600 / 60), static_cast<Time::second_t>(time % 60),
+                              static_cast<Time::ms_t>((fraction * 1000) >> 32)};
+            }
+
+            void pack(utils::BitWriter& writer, const type_t& value) const
+            {
+                // Days since 1970-01-01 of the civil date (H. Hinnant)
+                const int64_t  yr  = value.year() - (value.month() <= 2);
+                const int64_t  era = (yr >= 0 ? yr : yr - 399) / 400;
+                const uint64_t yoe = static_cast<uint64_t>(yr - era * 400);
+                const uint64_t doy = (153 * (value.month() + (value.month() > 2 ? -3 : 9)) + 2) / 5 + value.day() - 1;
+                const uint64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+                const int64_t  days = era * 146097 + static_cast<int64_t>(doe) - 719468 + days_1900_to_1970;
+
+                const int64_t seconds = days * 86400 + value.hour() * 3600 + value.minute() * 60 + value.second();
+
+                if(seconds < static_cast<int64_t>(era_start) || seconds >= static_cast<int64_t>(era_start + (uint64_t{1} << 32)))
+                    throw iolink::utils::exception_argument(__func__, "Time is out of the range of TimeT");
+
+                // Rounded up, so that unpack() gives back the same milliseconds
+                const uint64_t fraction = ((uint64_t{value.ms()} << 32) + 999) / 1000;
+
+                writer.write(static_cast<uint32_t>(seconds), 32);
+                writer.write(fraction, 32);
+            }
+
+            // Replaced by unpack() and pack(), kept for compatibility. Takes the value from the end of the vector
+            type_t unpackFromVector(vector_t& vector) const
+            {
+                return detail::unpackFromVector(*this, vector);
+            }
+
+            void packToVector(vector_t& vector, const type_t& value) const
+            {
+                detail::packToVector(*this, vector, value);
+            }
+
+        private:
+            static constexpr int64_t  days_1900_to_1970 = 25567;
+            static constexpr uint64_t era_start         = uint64_t{1} << 31;
     };
 }
 
@@ -21,11 +21,10 @@
 #ifndef IODD_TIMESPAN_H
 #define IODD_TIMESPAN_H
 
+#include "../bitstream.h"
 #include "../inc.h"
 #include "../exception.h"
-
-// TODO: implement unpackFromVector()
-// TODO: implement packToVector()
+#include "iodd_datatypetraits.h"
 
 namespace iolink::iodd
 {
@@ -57,7 +56,7 @@ namespace iolink::iodd
                 setTimeSpan(str);
             }
 
-            TimeSpan(const hour_t hour = 0, const minute_t minute = 0, const second_t second = 0, const ms_t ms = 0, const sign_t sign = true)
+            TimeSpan(const hour_t hour, const minute_t minute = 0, const second_t second = 0, const ms_t ms = 0, const sign_t sign = true)
             {
                 setTimeSpan(hour, minute, second, ms, sign);
             }
@@ -136,6 +135,8 @@ namespace iolink::iodd
             using type_t = TimeSpan;
             using iodd_type_t = int64_t;
 
+            static constexpr uint8_t bit_length = 64;
+
             TimeSpanT(const TimeSpanT&) =delete;
             TimeSpanT(TimeSpanT&&) =delete;
             TimeSpanT& operator =(const TimeSpanT&) =delete;
@@ -168,6 +169,27 @@ namespace iolink::iodd
             {
                 return value;
             }
+
+            type_t unpack(utils::BitReader& reader) const
+            {
+                return type_t{static_cast<iodd_type_t>(reader.read(bit_length))};
+            }
+
+            void pack(utils::BitWriter& writer, const type_t& value) const
+            {
+                writer.write(static_cast<uint64_t>(static_cast<iodd_type_t>(value)), bit_length);
+            }
+
+            // Replaced by unpack() and pack(), kept for compatibility. Takes the value from the end of the vector
+            type_t unpackFromVector(vector_t& vector) const
+            {
+                return detail::unpackFromVector(*this, vector);
+            }
+
+            void packToVector(vector_t& vector, const type_t& value) const
+            {
+                detail::packToVector(*this, vector, value);
+            }
     };
 }
 
@@ -0,0 +1,125 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+
+#ifndef IODD_DATATYPETRAITS_H
+#define IODD_DATATYPETRAITS_H
+
+#include "../bitstream.h"
+#include "../inc.h"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace iolink::iodd::detail
+{
+    template<typename T>
+    struct MemberPointer;
+
+    template<typename Struct, typename T>
+    struct MemberPointer<T Struct::*>
+    {
+        using struct_t = Struct;
+        using value_t  = T;
+    };
+
+    // Compares pointers to members that may have different types
+    template<auto a, auto b>
+    constexpr bool isSameMember()
+    {
+        if constexpr(std::is_same_v<decltype(a), decltype(b)>)
+            return a == b;
+        else
+            return false;
+    }
+
+    // Type of the item of a record. The lookup is deferred until the member is known
+    template<typename Record, auto member>
+    struct ItemValue
+    {
+        using type = typename Record::template item_t<member>::value_t;
+    };
+
+    // Types of variable length, the strings, give their length at run time through bitLength()
+    template<typename IODDType, typename = void>
+    struct HasBitLength: std::false_type {};
+
+    template<typename IODDType>
+    struct HasBitLength<IODDType, std::void_t<decltype(IODDType::bit_length)>>: std::true_type {};
+
+    template<typename IODDType>
+    std::size_t bitLength(const IODDType &type)
+    {
+        if constexpr(HasBitLength<IODDType>::value)
+            return IODDType::bit_length;
+        else
+            return type.bitLength();
+    }
+
+    /*
+     * The vector based interface that pack() and unpack() replaced. unpackFromVector() takes the value from the least
+     * significant bits at the end of the vector and shifts the rest of the vector right by the length of the type.
+     * packToVector() is its inverse.
+     */
+    template<typename IODDType>
+    typename IODDType::type_t unpackFromVector(const IODDType &type, vector_t &vector)
+    {
+        const std::size_t bits = bitLength(type);
+
+        if(bits > vector.size() * 8)
+            throw iolink::utils::exception_argument(__func__, "Vector is shorter than the type");
+
+        utils::BitReader reader{vector.data(), vector.size()};
+        reader.seek(reader.size() - bits);
+        auto value = type.unpack(reader);
+
+        vector.resize(vector.size() - bits / 8);
+
+        if(const std::size_t shift = bits % 8)
+            for(std::size_t i = vector.size(); i-- > 0;)
+                vector[i] = static_cast<uint8_t>((vector[i] >> shift) | (i > 0 ? vector[i - 1] << (8 - shift) : 0));
+
+        return value;
+    }
+
+    // A vector holding values that are not byte aligned must be sized in advance with the bytes those bits occupy
+    template<typename IODDType>
+    void packToVector(const IODDType &type, vector_t &vector, const typename IODDType::type_t &value)
+    {
+        const std::size_t bits = bitLength(type);
+
+        if(const std::size_t shift = bits % 8)
+        {
+            if(vector.empty())
+                vector.push_back(0);
+
+            for(std::size_t i = 0; i < vector.size(); ++i)
+                vector[i] = static_cast<uint8_t>((vector[i] << shift) | (i + 1 < vector.size() ? vector[i + 1] >> (8 - shift) : 0));
+        }
+
+        vector.resize(vector.size() + bits / 8);
+
+        utils::BitWriter writer{vector.data(), vector.size()};
+        writer.seek(writer.size() - bits);
+        type.pack(writer, value);
+    }
+}
+
+#endif // IODD_DATATYPETRAITS_H
@@ -21,19 +21,19 @@
 #ifndef IODD_DATATYPEUINT_H
 #define IODD_DATATYPEUINT_H
 
+#include "../bitstream.h"
 #include "../utils.h"
 #include "../inc.h"
 #include "../exception.h"
-
-// TODO: implement packToVector()
+#include "iodd_datatypetraits.h"
 
 namespace iolink::iodd
 {
-    template <uint8_t bit_length,
-              typename Type = typename std::conditional_t<(bit_length >= 2 && bit_length <= 8), uint8_t,
-                                                        typename std::conditional_t<(bit_length >= 9 && bit_length <= 16), uint16_t,
-                                                                                  typename std::conditional_t<(bit_length >= 17 && bit_length <= 32), uint32_t,
-                                                                                                            typename std::enable_if<(bit_length >= 33 && bit_length <= 64), uint64_t>
+    template <uint8_t length,
+              typename Type = typename std::conditional_t<(length >= 2 && length <= 8), uint8_t,
+                                                        typename std::conditional_t<(length >= 9 && length <= 16), uint16_t,
+                                                                                  typename std::conditional_t<(length >= 17 && length <= 32), uint32_t,
+                                                                                                            std::conditional_t<(length >= 33 && length <= 64), uint64_t, void>
                                                                                                             >
                                                                                   >
                                                         >>
@@ -43,6 +43,8 @@ namespace iolink::iodd
             using type_t = Type;
             using iodd_type_t = Type;
 
+            static constexpr uint8_t bit_length = length;
+
             UIntegerT(const UIntegerT&) =delete;
             UIntegerT(UIntegerT&&) =delete;
             UIntegerT& operator =(const UIntegerT&) =delete;
@@ -107,37 +109,25 @@ namespace iolink::iodd
                 return value;
             }
 
-            type_t unpackFromVector(vector_t& vector) const
+            type_t unpack(utils::BitReader& reader) const
             {
-                constexpr auto bytes = bit_length / 8;
-                constexpr auto bits  = bit_length % 8;
-
-                type_t value = 0;
-                for(std::size_t i = 0; i < bytes; ++i)
-                {
-                    value |= type_t(vector.back()) << (i * 8);
-                    vector.pop_back();
-                }
-
-                if(bits)
-                {
-                    auto mask = utils::createBitMask<uint8_t, bits>();
+                return static_cast<type_t>(reader.read(bit_length));
+            }
 
-                    value |= type_t(vector.back() & mask) << (bytes * 8);
+            void pack(utils::BitWriter& writer, const type_t& value) const
+            {
+                writer.write(static_cast<uint64_t>(value), bit_length);
+            }
 
-                    uint8_t bits_transfer = 0;  // Bits from the previous byte
-                    for(auto& el: vector)
-                    {
-                        uint8_t bits_poped = el & mask ;  // Bits to be shifted right
-                        el = (el >> bits) | (bits_transfer << ( 8 - bits));  // Shift right the bits and apply the bits shifted from the previous byte
-                        bits_transfer = bits_poped;  // Save the right shifted bits
-                    }
-                }
-                return value;
+            // Replaced by unpack() and pack(), kept for compatibility. Takes the value from the end of the vector
+            type_t unpackFromVector(vector_t& vector) const
+            {
+                return detail::unpackFromVector(*this, vector);
             }
 
             void packToVector(vector_t& vector, const type_t& value) const
             {
+                detail::packToVector(*this, vector, value);
             }
 
             string_t description(type_t value) const
@@ -0,0 +1,159 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef IODD_PARAMETERCACHE_H
+#define IODD_PARAMETERCACHE_H
+
+#include "../inc.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace iolink::iodd
+{
+    /*
+     * Read-through cache of device parameters, owned by a driver. Parameters are cached only if a TTL is set for
+     * them, either individually or with the default TTL. The values are kept in their raw hex form as returned by
+     * the master. All methods are thread safe.
+     */
+    class ParameterCache
+    {
+        public:
+            using steady_clock_t = std::chrono::steady_clock;
+            using duration_t     = std::chrono::milliseconds;
+
+            // TTL of parameters that never change while the device stays in operate state
+            static constexpr duration_t forever = duration_t::max();
+
+            explicit ParameterCache(duration_t default_ttl = duration_t::zero(), duration_t status_check_interval = std::chrono::seconds{1}):
+                m_default_ttl{default_ttl},
+                m_status_check_interval{status_check_interval}
+            {}
+
+            void setDefaultTtl(duration_t ttl)
+            {
+                std::lock_guard lock{m_mutex};
+                m_default_ttl = ttl;
+            }
+
+            // Zero TTL disables caching of the parameter
+            void setTtl(uint32_t index, uint32_t sub_index, duration_t ttl)
+            {
+                std::lock_guard lock{m_mutex};
+                m_ttl[{index, sub_index}] = ttl;
+                m_entries.erase({index, sub_index});
+            }
+
+            template<template<uint32_t, uint32_t, typename> class Access, uint32_t index, uint32_t sub_index, typename IODDType>
+            void setTtl(const Access<index, sub_index, IODDType>&, duration_t ttl)
+            {
+                setTtl(index, sub_index, ttl);
+            }
+
+            // Returns the cached value if it is not expired
+            std::optional<string_t> find(uint32_t index, uint32_t sub_index) const
+            {
+                std::lock_guard lock{m_mutex};
+
+                auto it = m_entries.find({index, sub_index});
+                if(it == m_entries.end() || steady_clock_t::now() >= it->second.expires)
+                    return std::nullopt;
+
+                return it->second.value;
+            }
+
+            // Stores the value, if the parameter is cached at all
+            void store(uint32_t index, uint32_t sub_index, const string_t &value)
+            {
+                std::lock_guard lock{m_mutex};
+
+                auto ttl = m_default_ttl;
+                if(auto it = m_ttl.find({index, sub_index}); it != m_ttl.end())
+                    ttl = it->second;
+
+                if(ttl <= duration_t::zero())
+                    return;
+
+                auto now = steady_clock_t::now();
+                auto expires = (ttl >= std::chrono::duration_cast<duration_t>(steady_clock_t::time_point::max() - now)) ? steady_clock_t::time_point::max() : now + ttl;
+
+                m_entries[{index, sub_index}] = Entry{value, expires};
+            }
+
+            void invalidate(uint32_t index, uint32_t sub_index)
+            {
+                std::lock_guard lock{m_mutex};
+                m_entries.erase({index, sub_index});
+            }
+
+            // Drops all the subindices of the index, e.g. a record together with its items
+            void invalidateIndex(uint32_t index)
+            {
+                std::lock_guard lock{m_mutex};
+                m_entries.erase(m_entries.lower_bound({index, 0}), m_entries.upper_bound({index, std::numeric_limits<uint32_t>::max()}));
+            }
+
+            void invalidate()
+            {
+                std::lock_guard lock{m_mutex};
+                m_entries.clear();
+            }
+
+            /*
+             * Returns true if the device status must be checked before serving a value from the cache. The status is
+             * checked at most once per status check interval.
+             */
+            bool statusCheckDue()
+            {
+                std::lock_guard lock{m_mutex};
+
+                if(m_entries.empty())
+                    return false;
+
+                // The first served value always checks the status
+                auto now = steady_clock_t::now();
+                if(m_status_checked != steady_clock_t::time_point{} && now - m_status_checked < m_status_check_interval)
+                    return false;
+
+                m_status_checked = now;
+                return true;
+            }
+
+        private:
+            struct Entry
+            {
+                string_t                   value;
+                steady_clock_t::time_point expires;
+            };
+
+            using key_t = std::pair<uint32_t, uint32_t>;
+
+            mutable std::mutex          m_mutex;
+            std::map<key_t, Entry>      m_entries;
+            std::map<key_t, duration_t> m_ttl;
+            duration_t                  m_default_ttl;
+            const duration_t            m_status_check_interval;
+            steady_clock_t::time_point  m_status_checked{};
+    };
+}
+
+#endif // IODD_PARAMETERCACHE_H
@@ -0,0 +1,292 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef IODD_PARAMETERSET_H
+#define IODD_PARAMETERSET_H
+
+#include "iodd_basedriver.h"
+#include "iodd_parametertable.h"
+
+#include <atomic>
+#include <map>
+
+namespace iolink::iodd
+{
+    // Outcome of a single operation of a ParameterSet
+    struct ParameterResult
+    {
+        string_t           value;  // Raw hex value read from or written to the device
+        std::exception_ptr error;
+        std::atomic<bool>  done{false};  // Set after the value and the error by the thread completing the operation
+
+        ParameterResult() = default;
+
+        ParameterResult(const ParameterResult &other)
+        {
+            *this = other;
+        }
+
+        // The value and the error are copied only once the operation is completed
+        ParameterResult& operator=(const ParameterResult &other)
+        {
+            if(this == &other)
+                return *this;
+
+            bool completed = other.done.load(std::memory_order_acquire);
+
+            value = completed ? other.value : string_t{};
+            error = completed ? other.error : nullptr;
+            done.store(completed, std::memory_order_release);
+
+            return *this;
+        }
+
+        bool isOk() const
+        {
+            return done.load(std::memory_order_acquire) && !error;
+        }
+    };
+
+    // Typed view of a parameter read or written by a ParameterSet
+    template<typename Parameter>
+    class ParameterValue
+    {
+        public:
+            using type_t = typename Parameter::type_t;
+
+            bool isReady() const
+            {
+                return m_result->done.load(std::memory_order_acquire);
+            }
+
+            bool isOk() const
+            {
+                return m_result->isOk();
+            }
+
+            std::exception_ptr error() const
+            {
+                return m_result->error;
+            }
+
+            // Throws the error of this parameter, if there is one
+            type_t get() const
+            {
+                if(!m_result->done.load(std::memory_order_acquire))
+                    throw iolink::utils::exception_logic(__func__, "Parameter set not executed");
+
+                if(m_result->error)
+                    std::rethrow_exception(m_result->error);
+
+                return m_parameter->toType(utils::hexDecode<typename Parameter::iodd_type_t>(m_result->value));
+            }
+
+        private:
+            friend class ParameterSet;
+
+            ParameterValue(const Parameter &parameter, std::shared_ptr<const ParameterResult> result):
+                m_parameter{&parameter},
+                m_result{std::move(result)}
+            {}
+
+        private:
+            const Parameter*                       m_parameter;
+            std::shared_ptr<const ParameterResult> m_result;
+    };
+
+    /*
+     * Reads and writes many parameters of a device at once. All the operations are handed to the asynchronous API
+     * together, so the transport can keep as many of them in flight as it supports. A failed operation is
+     * reported in its own result and does not abort the others.
+     *
+     * Example:
+     *
+     *     iolink::iodd::ParameterSet set{*o1d105_drv};
+     *     auto serial = set.read(o1d105_drv->serial_number);
+     *     set.read(o1d105_drv->dS1);
+     *     set.execute();
+     *
+     *     if(serial.isOk())
+     *         std::cout << serial.get();
+     *
+     * Reads always go to the device, bypassing the parameter cache of the driver. The operations are not ordered,
+     * so do not read and write the same parameter in one set.
+     */
+    class ParameterSet
+    {
+        public:
+            using key_t = std::pair<uint32_t, uint32_t>;
+
+            explicit ParameterSet(const BaseDriver &driver):
+                m_driver{driver}
+            {}
+
+            void read(uint32_t index, uint32_t sub_index = 0)
+            {
+                add(index, sub_index, false, string_t{});
+            }
+
+            void read(const std::vector<key_t> &parameters)
+            {
+                for(const auto &[index, sub_index]: parameters)
+                    read(index, sub_index);
+            }
+
+            template<typename Parameter>
+            ParameterValue<Parameter> read(const Parameter &parameter)
+            {
+                return {parameter, add(Parameter::parameter_index, Parameter::parameter_subindex, false, string_t{})};
+            }
+
+            // The value is validated immediately
+            template<typename Parameter>
+            ParameterValue<Parameter> write(const Parameter &parameter, typename Parameter::type_t value)
+            {
+                if(!parameter.isValid(value))
+                    throw iolink::utils::exception_iodd(__func__, iolink::utils::exception_iodd::ErrorCodeType::ERROR_INVALID_VALUE);
+
+                return {parameter, add(Parameter::parameter_index, Parameter::parameter_subindex, true, utils::hexEncode(parameter.toIoddType(value)))};
+            }
+
+            // Writes a raw hex value. It is not validated
+            void write(uint32_t index, uint32_t sub_index, string_t hex)
+            {
+                add(index, sub_index, true, std::move(hex));
+            }
+
+            // Reads every readable parameter from the parameter table of the driver
+            template<typename Driver>
+            void readAll(const Driver &driver)
+            {
+                if(static_cast<const BaseDriver*>(&driver) != &m_driver)
+                    throw iolink::utils::exception_argument(__func__, "The driver is not the one of this parameter set");
+
+                forEachParameter<Driver>([this, &driver](const auto &info)
+                {
+                    if constexpr(std::decay_t<decltype(info)>::readable)
+                        read(info.get(driver));
+                });
+            }
+
+            size_t size() const
+            {
+                return m_operations.size();
+            }
+
+            void clear()
+            {
+                m_operations.clear();
+            }
+
+            // Executes all the operations and waits until every one of them is completed
+            void execute() const
+            {
+                executeAsync().wait();
+            }
+
+            // The callback is invoked when every operation is completed. It never receives an error
+            void executeAsync(callback_t<void> callback) const
+            {
+                if(m_operations.empty())
+                    return callback(nullptr);
+
+                // Shared by the completions of all the operations. The last one invokes the callback
+                auto pending = std::make_shared<std::pair<std::atomic<size_t>, callback_t<void>>>(m_operations.size(), std::move(callback));
+
+                auto complete = [pending](const std::shared_ptr<ParameterResult> &result, string_t value, std::exception_ptr error)
+                {
+                    if(!error)
+                        result->value = std::move(value);
+
+                    result->error = error;
+                    result->done.store(true, std::memory_order_release);
+
+                    if(--pending->first == 0)
+                        pending->second(nullptr);
+                };
+
+                for(const auto &operation: m_operations)
+                {
+                    auto result = operation.result;
+                    *result = ParameterResult{};
+
+                    // Errors thrown before the request is sent are reported like the errors of the request itself
+                    try
+                    {
+                        if(operation.write)
+                            m_driver.writeParameterHexAsync(operation.value, operation.key.first, operation.key.second, [complete, result, value = operation.value](std::exception_ptr error)
+                            {
+                                complete(result, value, error);
+                            });
+                        else
+                            m_driver.getIOLinkDevice()->readHexAsync(operation.key.first, operation.key.second, [complete, result](string_t value, std::exception_ptr error)
+                            {
+                                complete(result, std::move(value), error);
+                            });
+                    }
+                    catch(...)
+                    {
+                        complete(result, string_t{}, std::current_exception());
+                    }
+                }
+            }
+
+            std::future<void> executeAsync() const
+            {
+                auto [future, callback] = utils::makeFutureCallback<void>();
+                executeAsync(std::move(callback));
+                return std::move(future);
+            }
+
+            // Results of the last execution by index and subindex
+            std::map<key_t, ParameterResult> results() const
+            {
+                std::map<key_t, ParameterResult> results;
+
+                for(const auto &operation: m_operations)
+                    results[operation.key] = *operation.result;
+
+                return results;
+            }
+
+        private:
+            struct Operation
+            {
+                key_t                            key;
+                bool                             write;
+                string_t                         value;  // Hex value of a write
+                std::shared_ptr<ParameterResult> result;
+            };
+
+            std::shared_ptr<const ParameterResult> add(uint32_t index, uint32_t sub_index, bool write, string_t value)
+            {
+                auto result = std::make_shared<ParameterResult>();
+                m_operations.push_back(Operation{{index, sub_index}, write, std::move(value), result});
+
+                return result;
+            }
+
+        private:
+            const BaseDriver&      m_driver;
+            std::vector<Operation> m_operations;
+    };
+}
+
+#endif // IODD_PARAMETERSET_H
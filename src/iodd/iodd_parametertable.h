@@ -0,0 +1,85 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef IODD_PARAMETERTABLE_H
+#define IODD_PARAMETERTABLE_H
+
+#include "iodd_dataaccess.h"
+
+#include <tuple>
+
+/*
+ * Entry of the parameter table of a driver. Every driver lists its parameters in a static constexpr function:
+ *
+ *     static constexpr auto parameters()
+ *     {
+ *         return std::make_tuple(IOLINK_PARAMETER(O1D105, vendor_name),
+ *                                IOLINK_PARAMETER(O1D105, dS1));
+ *     }
+ */
+#define IOLINK_PARAMETER(driver, member) iolink::iodd::parameterInfo(#member, &driver::member)
+
+namespace iolink::iodd
+{
+    // Compile time description of a parameter member of a driver
+    template<typename Driver, typename Parameter>
+    struct ParameterInfo
+    {
+        using driver_t    = Driver;
+        using parameter_t = Parameter;
+        using type_t      = typename Parameter::type_t;
+        using iodd_type_t = typename Parameter::iodd_type_t;
+
+        static constexpr uint32_t   index     = Parameter::parameter_index;
+        static constexpr uint32_t   sub_index = Parameter::parameter_subindex;
+        static constexpr AccessMode access    = Parameter::access_mode;
+        static constexpr bool       readable  = (access != AccessMode::WRITE);
+        static constexpr bool       writable  = (access != AccessMode::READ);
+
+        const char*          name;
+        Parameter Driver::*  member;
+
+        const Parameter& get(const Driver &driver) const
+        {
+            return driver.*member;
+        }
+    };
+
+    template<typename Driver, typename Parameter>
+    constexpr ParameterInfo<Driver, Parameter> parameterInfo(const char *name, Parameter Driver::*member)
+    {
+        return {name, member};
+    }
+
+    template<typename Driver>
+    constexpr size_t parameterCount()
+    {
+        return std::tuple_size_v<decltype(Driver::parameters())>;
+    }
+
+    // Invokes the function with the ParameterInfo of every parameter of the driver, in the order of the table
+    template<typename Driver, typename Function>
+    constexpr void forEachParameter(Function &&function)
+    {
+        std::apply([&function](const auto& ... info){(function(info), ...);}, Driver::parameters());
+    }
+}
+
+#endif // IODD_PARAMETERTABLE_H
@@ -0,0 +1,205 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef IODD_PROCESSDATA_H
+#define IODD_PROCESSDATA_H
+
+#include "iodd_datatypeboolean.h"
+#include "iodd_datatypefloat32.h"
+#include "iodd_datatypeint.h"
+#include "iodd_datatypeuint.h"
+#include "iodd_datatypetraits.h"
+
+#include <array>
+#include <cstring>
+
+namespace iolink::iodd
+{
+    /*
+     * Field of a process data layout. The bit offset follows the IO-Link convention: offset 0 is the least significant
+     * bit of the last byte of the process data. The IODD type gives the length and the encoding of the field.
+     */
+    template<auto member, uint16_t offset, typename IODDType>
+    struct Field
+    {
+        using struct_t    = typename detail::MemberPointer<decltype(member)>::struct_t;
+        using value_t     = typename detail::MemberPointer<decltype(member)>::value_t;
+        using iodd_type_t = IODDType;
+
+        static constexpr uint16_t bit_offset = offset;
+        static constexpr uint8_t  bit_length = IODDType::bit_length;
+
+        static_assert(bit_length >= 1 && bit_length <= 64, "Field must be 1 to 64 bits long");
+        static_assert(offset % 8 + bit_length <= 64, "Field must span at most 8 bytes");
+
+        template<size_t size>
+        static constexpr void decode(const std::array<uint8_t, size> &data, struct_t &output) noexcept
+        {
+            static_assert(offset + bit_length <= size * 8, "Field does not fit into the process data");
+
+            const uint64_t raw = (load(data) >> (offset % 8)) & mask;
+
+            if constexpr(std::is_same_v<typename IODDType::type_t, bool>)
+                output.*member = raw != 0;
+            else if constexpr(std::is_floating_point_v<typename IODDType::type_t>)
+            {
+                const uint32_t bits = static_cast<uint32_t>(raw);
+                float value = 0;
+                std::memcpy(&value, &bits, sizeof(value));
+                output.*member = static_cast<value_t>(value);
+            }
+            else if constexpr(std::is_signed_v<typename IODDType::type_t>)
+            {
+                // Sign extension of the most significant bit of the field
+                constexpr unsigned shift = 64 - bit_length;
+                output.*member = static_cast<value_t>(static_cast<int64_t>(raw << shift) >> shift);
+            }
+            else
+                output.*member = static_cast<value_t>(raw);
+        }
+
+        template<size_t size>
+        static constexpr void encode(const struct_t &input, std::array<uint8_t, size> &data) noexcept
+        {
+            static_assert(offset + bit_length <= size * 8, "Field does not fit into the process data");
+
+            uint64_t raw = 0;
+
+            if constexpr(std::is_floating_point_v<typename IODDType::type_t>)
+            {
+                const float value = static_cast<float>(input.*member);
+                uint32_t bits = 0;
+                std::memcpy(&bits, &value, sizeof(bits));
+                raw = bits;
+            }
+            else
+                raw = static_cast<uint64_t>(input.*member) & mask;
+
+            // Read, modify, write of the bytes that hold the field
+            const uint64_t word = (load(data) & ~(mask << (offset % 8))) | (raw << (offset % 8));
+
+            for(size_t i = 0; i < bytes; ++i)
+                data[lastIndex<size>() - i] = static_cast<uint8_t>(word >> (8 * i));
+        }
+
+        private:
+            static constexpr uint64_t mask  = bit_length == 64 ? ~uint64_t{0} : (uint64_t{1} << bit_length) - 1;
+            static constexpr size_t   bytes = (offset % 8 + bit_length + 7) / 8;
+
+            // Index of the byte holding the bit at the offset, counted from the end of the process data
+            static constexpr size_t   first_from_end = offset / 8;
+
+            template<size_t size>
+            static constexpr size_t lastIndex()
+            {
+                return size - 1 - first_from_end;
+            }
+
+            // The bytes of the field as big endian word, with the byte at the offset in the least significant byte
+            template<size_t size>
+            static constexpr uint64_t load(const std::array<uint8_t, size> &data) noexcept
+            {
+                uint64_t word = 0;
+
+                for(size_t i = 0; i < bytes; ++i)
+                    word |= uint64_t{data[lastIndex<size>() - i]} << (8 * i);
+
+                return word;
+            }
+    };
+
+    /*
+     * Process data of a fixed length, decoded into and encoded from a plain struct. The decoder is generated from the
+     * fields at compile time and does not allocate.
+     *
+     * Example:
+     *
+     *     struct ProcessData
+     *     {
+     *         int16_t distance = 0;
+     *         bool    out1     = false;
+     *     };
+     *
+     *     using Layout = ProcessDataLayout<ProcessData, 8,
+     *                                      Field<&ProcessData::distance, 48, IntegerT<16>>,
+     *                                      Field<&ProcessData::out1,      0, BooleanT>>;
+     *
+     *     ProcessData data = Layout::decode(iolink_device->pdin.getData());
+     */
+    template<typename Struct, size_t size, typename ... Fields>
+    struct ProcessDataLayout
+    {
+        using struct_t = Struct;
+        using buffer_t = std::array<uint8_t, size>;
+
+        static constexpr size_t byte_length = size;
+
+        static_assert((std::is_same_v<typename Fields::struct_t, Struct> && ...), "All the fields must be members of the struct");
+
+        static constexpr Struct decode(const buffer_t &data) noexcept
+        {
+            Struct output{};
+            (Fields::decode(data, output), ...);
+            return output;
+        }
+
+        // The buffer must hold exactly byte_length bytes
+        static Struct decode(const uint8_t *data, size_t length)
+        {
+            if(length != size)
+                throw iolink::utils::exception_argument(__func__, "Process data must be " + std::to_string(size) + " bytes long");
+
+            buffer_t buffer;
+            std::memcpy(buffer.data(), data, size);
+
+            return decode(buffer);
+        }
+
+        // Decodes the hex string of pdin or pdout
+        static Struct decode(const string_t &hex)
+        {
+            buffer_t buffer;
+
+            if(hex.size() != 2 * size || !utils::hexDecode(hex.data(), hex.size(), buffer.data()))
+                throw iolink::utils::exception_argument(__func__, "Process data must be " + std::to_string(2 * size) + " hex digits");
+
+            return decode(buffer);
+        }
+
+        // The bits that are not part of any field are zero
+        static constexpr buffer_t encode(const Struct &input) noexcept
+        {
+            buffer_t data{};
+            (Fields::encode(input, data), ...);
+            return data;
+        }
+
+        static string_t encodeHex(const Struct &input)
+        {
+            const buffer_t data = encode(input);
+            string_t hex(2 * size, '0');
+            utils::hexEncode(data.data(), data.size(), hex.data());
+
+            return hex;
+        }
+    };
+}
+
+#endif // IODD_PROCESSDATA_H
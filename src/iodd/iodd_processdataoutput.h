@@ -0,0 +1,252 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+
+#ifndef IODD_PROCESSDATAOUTPUT_H
+#define IODD_PROCESSDATAOUTPUT_H
+
+#include "iodd_basedriver.h"
+#include "iodd_processdata.h"
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+
+namespace iolink::iodd
+{
+    /*
+     * Typed writer of the process data output of a device. The value is encoded through a ProcessDataLayout and the
+     * write to pdout is skipped when the encoded bytes equal the last value written by this object, so it can be called
+     * every scan cycle. A write that fails is forgotten and the next one goes out. The writes are serialized, see
+     * writeAsync().
+     *
+     * The master does not report changes of pdout made by others, or the reset of the outputs when the device
+     * reconnects. Call invalidate() in that case, or set a maximum age after which an unchanged value is written
+     * again.
+     *
+     * Example:
+     *
+     *     ProcessDataOutput<Layout> output{*driver};
+     *     output.write(Outputs{true, 1200});  // Sent
+     *     output.write(Outputs{true, 1200});  // Skipped
+     */
+    template<typename Layout>
+    class ProcessDataOutput
+    {
+        public:
+            using struct_t   = typename Layout::struct_t;
+            using buffer_t   = typename Layout::buffer_t;
+            using clock_t    = std::chrono::steady_clock;
+            using duration_t = clock_t::duration;
+
+            ProcessDataOutput(const ProcessDataOutput&) =delete;
+            ProcessDataOutput(ProcessDataOutput&&) =delete;
+            ProcessDataOutput& operator= (const ProcessDataOutput&) =delete;
+            ProcessDataOutput& operator= (ProcessDataOutput&&) =delete;
+            ~ProcessDataOutput() =default;
+
+            // A zero maximum age never repeats an unchanged value
+            explicit ProcessDataOutput(std::weak_ptr<IOLinkDevice> iolink_device, duration_t max_age = duration_t::zero()):
+                m_iolink_device{std::move(iolink_device)},
+                m_max_age{max_age}
+            {}
+
+            explicit ProcessDataOutput(const BaseDriver &driver, duration_t max_age = duration_t::zero()):
+                ProcessDataOutput{driver.getIOLinkDevice(), max_age}
+            {}
+
+            /*
+             * Returns false if the write was skipped because the value did not change. The write waits for the
+             * asynchronous writes before it, so do not call it from the callback of writeAsync().
+             */
+            bool write(const struct_t &value, bool force = false)
+            {
+                return writeAsync(value, force).get();
+            }
+
+            /*
+             * Only one write is in flight at a time, so the values reach the master in order and last() stays the value
+             * of the device. A write issued meanwhile waits for the one in flight, and a newer write replaces it. A
+             * value equal to the one in flight is skipped as well.
+             *
+             * The callback receives false for a skipped or replaced write and is then invoked on the calling thread.
+             * The object must outlive the writes in flight.
+             */
+            void writeAsync(const struct_t &value, callback_t<bool> callback, bool force = false)
+            {
+                buffer_t         data = Layout::encode(value);
+                callback_t<bool> replaced;
+                bool             send_now = false;
+                bool             queued   = false;
+
+                {
+                    std::lock_guard lock{m_mutex};
+
+                    if(m_in_flight)
+                    {
+                        if(m_pending)
+                            replaced = std::move(m_pending->callback);
+
+                        m_pending.reset();
+
+                        if(force || m_last != data)
+                        {
+                            m_pending = Pending{data, std::move(callback)};
+                            queued    = true;
+                        }
+                    }
+                    else
+                        send_now = m_in_flight = claim(data, force);
+                }
+
+                if(replaced)
+                    replaced(false, nullptr);
+
+                if(send_now)
+                    send(std::move(data), std::move(callback));
+                else if(!queued)
+                    callback(false, nullptr);
+            }
+
+            std::future<bool> writeAsync(const struct_t &value, bool force = false)
+            {
+                auto [future, callback] = utils::makeFutureCallback<bool>();
+                writeAsync(value, std::move(callback), force);
+                return std::move(future);
+            }
+
+            // The next write is sent even if the value did not change
+            void invalidate()
+            {
+                std::lock_guard lock{m_mutex};
+                m_last.reset();
+            }
+
+            // Last value written, if it is still considered current
+            std::optional<buffer_t> last() const
+            {
+                std::lock_guard lock{m_mutex};
+                return m_last;
+            }
+
+        private:
+            std::shared_ptr<IOLinkDevice> device() const
+            {
+                if(auto iolink_device = m_iolink_device.lock())
+                    return iolink_device;
+
+                throw iolink::utils::exception_logic(__func__, "Can't create a shared pointer to IOLinkDevice");
+            }
+
+            struct Pending
+            {
+                buffer_t         data;
+                callback_t<bool> callback;
+            };
+
+            // Records the value as written. Returns false if the write can be skipped. The mutex must be locked
+            bool claim(const buffer_t &data, bool force)
+            {
+                const auto now = clock_t::now();
+                const bool expired = m_max_age != duration_t::zero() && now - m_written_at >= m_max_age;
+
+                if(!force && !expired && m_last == data)
+                    return false;
+
+                m_last       = data;
+                m_written_at = now;
+
+                return true;
+            }
+
+            void send(buffer_t data, callback_t<bool> callback)
+            {
+                try
+                {
+                    device()->pdout.setDataAsync(toHex(data), [this, data, callback](json_t, std::exception_ptr error)
+                    {
+                        complete(data, callback, error);
+                    });
+                }
+                catch(...)
+                {
+                    complete(data, callback, std::current_exception());
+                }
+            }
+
+            // Sends the pending write, if there is one, after the callback of the completed write
+            void complete(const buffer_t &data, const callback_t<bool> &callback, std::exception_ptr error)
+            {
+                std::optional<Pending> next;
+
+                {
+                    std::lock_guard lock{m_mutex};
+
+                    // A write that fails is forgotten and the next one goes out
+                    if(error && m_last == data)
+                        m_last.reset();
+
+                    next = std::exchange(m_pending, std::nullopt);
+
+                    if(next)
+                    {
+                        m_last       = next->data;
+                        m_written_at = clock_t::now();
+                    }
+                    else
+                        m_in_flight = false;
+                }
+
+                try
+                {
+                    callback(!error, error);
+                }
+                catch(...)
+                {
+                    if(next)
+                        send(std::move(next->data), std::move(next->callback));
+
+                    throw;
+                }
+
+                if(next)
+                    send(std::move(next->data), std::move(next->callback));
+            }
+
+            static string_t toHex(const buffer_t &data)
+            {
+                string_t hex(2 * data.size(), '0');
+                utils::hexEncode(data.data(), data.size(), hex.data());
+
+                return hex;
+            }
+
+        private:
+            const std::weak_ptr<IOLinkDevice> m_iolink_device;
+            const duration_t                  m_max_age;
+            mutable std::mutex                m_mutex;
+            std::optional<buffer_t>           m_last;
+            clock_t::time_point               m_written_at;
+            std::optional<Pending>            m_pending;  // Newest write issued while another one is in flight
+            bool                              m_in_flight = false;
+    };
+}
+
+#endif // IODD_PROCESSDATAOUTPUT_H
@@ -22,10 +22,69 @@
 #define BASE_H
 
 #include "interfacecomm.h"
+#include "responseview.h"
 #include "../exception.h"
 
 namespace iolink::iot
 {
+    /*
+     * Pre-serialized request for a service of an element, for example "/getdata" of a pdin. The address of an
+     * element is fixed after construction, so the request is built once and every call only writes the buffer.
+     */
+    class RequestTemplate
+    {
+        public:
+            explicit RequestTemplate(string_t adr):
+                m_adr{std::move(adr)},
+                m_head{R"({"adr":)"+json_t(m_adr).dump()},
+                m_body{m_head+R"(,"cid":-1,"code":"request"})"}
+            {}
+
+            // The address used for GET requests
+            const string_t& adr() const
+            {
+                return m_adr;
+            }
+
+            // Serialized POST request without security and data
+            const string_t& body() const
+            {
+                return m_body;
+            }
+
+            // Serialized POST request. The auth and the data must be serialized JSON objects or empty
+            string_t body(std::string_view auth, std::string_view data) const
+            {
+                if(auth.empty() && data.empty())
+                    return m_body;
+
+                string_t body;
+                body.reserve(m_body.size() + auth.size() + data.size() + 16);
+
+                // Keep the same key order as json_t::dump()
+                body += m_head;
+                if(!auth.empty())
+                {
+                    body += R"(,"auth":)";
+                    body += auth;
+                }
+                body += R"(,"cid":-1,"code":"request")";
+                if(!data.empty())
+                {
+                    body += R"(,"data":)";
+                    body += data;
+                }
+                body += '}';
+
+                return body;
+            }
+
+        private:
+            const string_t m_adr;
+            const string_t m_head;
+            const string_t m_body;
+    };
+
     // TODO: да го направя темплейт и да вкарам функциите на DataEvent и DataUnit.
     // Това не работи!!! Да измисля по-елегантен начин!!!
     // template<bool is_event, bool is_unit>
@@ -40,14 +99,10 @@ namespace iolink::iot
 
             virtual ~BaseElement() =default;
 
-            virtual string_t address() const
+            // Absolute address of the element. The root element is not part of it
+            virtual const string_t& address() const
             {
-                auto adr = (m_id.empty() || !m_parent)?string_t{}:string_t{"/" + m_id};
-
-                if(m_parent)
-                    adr.insert(0, m_parent->address());
-
-                return adr;
+                return m_address;
             }
 
             virtual string_t id() const
@@ -59,7 +114,9 @@ namespace iolink::iot
             BaseElement(const string_t& id, BaseElement* const parent = nullptr, std::unique_ptr<InterfaceComm> comm = nullptr):
                 m_comm{std::move(comm)},
                 m_parent{parent},
-                m_id{id}
+                m_id{id},
+                m_root{parent?parent->m_root:this},
+                m_address{parent?(id.empty()?parent->m_address:parent->m_address+"/"+id):string_t{}}
             {
                 if( (!m_parent && !m_comm) || (m_parent && m_comm))
                     throw iolink::utils::exception_argument(__func__, "Either Parent or Communication object must be set");
@@ -71,12 +128,7 @@ namespace iolink::iot
                     throw iolink::utils::exception_argument(__func__, "Address argument must be non empty string");
 
                 if(m_parent)
-                {
-                    if(!m_id.empty())
-                        adr.insert(0, "/"+m_id);
-
-                    return m_parent->requestGet(adr);
-                }
+                    return m_root->requestGet(m_address+adr);
 
                 if(!m_comm)
                     throw iolink::utils::exception_logic(__func__, "Communication object not set");
@@ -98,16 +150,169 @@ namespace iolink::iot
                     throw iolink::utils::exception_argument(__func__, "Address argument must be non empty string");
 
                 if(m_parent)
-                {
-                    if(!m_id.empty())
-                        adr.insert(0, "/"+m_id);
+                    return m_root->requestPost(m_address+adr, data);
 
-                    return m_parent->requestPost(adr, data);
-                }
+                return checkResponseCode(json_t::parse(httpPostRequest(adr, data)));
+            }
+
+            /*
+             * Same as requestGet()["data"]["value"] and requestPost()["data"]["value"], but the response is scanned
+             * with ResponseView instead of being parsed into a json_t.
+             */
+            template<typename T>
+            T requestGetValue(string_t adr) const
+            {
+                if(adr.empty())
+                    throw iolink::utils::exception_argument(__func__, "Address argument must be non empty string");
+
+                if(m_parent)
+                    return m_root->template requestGetValue<T>(m_address+adr);
 
                 if(!m_comm)
                     throw iolink::utils::exception_logic(__func__, "Communication object not set");
 
+                return responseValue<T>(m_comm->isSecurityMode() ? httpPostRequest(adr, {}) : m_comm->httpGet(adr));
+            }
+
+            template<typename T>
+            T requestPostValue(string_t adr, const json_t& data = {}) const
+            {
+                if(adr.empty())
+                    throw iolink::utils::exception_argument(__func__, "Address argument must be non empty string");
+
+                if(m_parent)
+                    return m_root->template requestPostValue<T>(m_address+adr, data);
+
+                return responseValue<T>(httpPostRequest(adr, data));
+            }
+
+            /*
+             * Reads many elements with a single /getdatamulti request. The request is always sent to the root of the
+             * tree, so it can be called from any element. The urls are absolute addresses as returned by address().
+             */
+            json_t requestDataMulti(std::vector<string_t> element_urls, bool consistent = false) const
+            {
+                if(m_parent)
+                    return m_root->requestDataMulti(std::move(element_urls), consistent);
+
+                json_t data = dataMultiRequest(std::move(element_urls), consistent);
+                if(data.empty()) return json_t{};
+
+                return requestPost("/getdatamulti", data);
+            }
+
+            void requestDataMultiAsync(std::vector<string_t> element_urls, bool consistent, callback_t<json_t> callback) const
+            {
+                if(m_parent)
+                    return m_root->requestDataMultiAsync(std::move(element_urls), consistent, std::move(callback));
+
+                json_t data = dataMultiRequest(std::move(element_urls), consistent);
+                if(data.empty()) return callback(json_t{}, nullptr);
+
+                requestPostAsync("/getdatamulti", data, std::move(callback));
+            }
+
+            // Builds the request for a service of this element. Keep it and pass it to the overloads below
+            RequestTemplate requestTemplate(const string_t& service) const
+            {
+                return RequestTemplate{address()+service};
+            }
+
+            json_t requestGet(const RequestTemplate& request) const
+            {
+                return checkResponseCode(json_t::parse(root().httpGetRequest(request)));
+            }
+
+            template<typename T>
+            T requestGetValue(const RequestTemplate& request) const
+            {
+                return responseValue<T>(root().httpGetRequest(request));
+            }
+
+            // The data must be a serialized JSON object or empty
+            json_t requestPost(const RequestTemplate& request, std::string_view data = {}) const
+            {
+                return checkResponseCode(json_t::parse(root().httpPostRequest(request, data)));
+            }
+
+            template<typename T>
+            T requestPostValue(const RequestTemplate& request, std::string_view data = {}) const
+            {
+                return responseValue<T>(root().httpPostRequest(request, data));
+            }
+
+            void requestGetAsync(const RequestTemplate& request, callback_t<json_t> callback) const
+            {
+                const auto &root_element = root();
+
+                if(!root_element.m_comm)
+                    return callback(json_t{}, std::make_exception_ptr(iolink::utils::exception_logic(__func__, "Communication object not set")));
+
+                if(root_element.m_comm->isSecurityMode())
+                    return requestPostAsync(request, {}, std::move(callback));
+
+                root_element.m_comm->httpGetAsync(request.adr(), makeResponseHandler(std::move(callback)));
+            }
+
+            void requestPostAsync(const RequestTemplate& request, std::string_view data, callback_t<json_t> callback) const
+            {
+                const auto &root_element = root();
+
+                if(!root_element.m_comm)
+                    return callback(json_t{}, std::make_exception_ptr(iolink::utils::exception_logic(__func__, "Communication object not set")));
+
+                root_element.m_comm->httpPostAsync(request.body(root_element.m_comm->authJson(), data), makeResponseHandler(std::move(callback)));
+            }
+
+            /*
+             * Asynchronous variants of requestGet() and requestPost(). The callback is invoked from the thread that
+             * completes the request, depending on the InterfaceComm implementation. Invalid arguments are reported
+             * through the callback too.
+             */
+            void requestGetAsync(string_t adr, callback_t<json_t> callback) const
+            {
+                if(adr.empty())
+                    return callback(json_t{}, std::make_exception_ptr(iolink::utils::exception_argument(__func__, "Address argument must be non empty string")));
+
+                if(m_parent)
+                    return m_root->requestGetAsync(m_address+adr, std::move(callback));
+
+                if(!m_comm)
+                    return callback(json_t{}, std::make_exception_ptr(iolink::utils::exception_logic(__func__, "Communication object not set")));
+
+                if(m_comm->isSecurityMode())
+                    return requestPostAsync(adr, json_t{}, std::move(callback));
+
+                m_comm->httpGetAsync(adr, makeResponseHandler(std::move(callback)));
+            }
+
+            void requestPostAsync(const string_t& adr, const string_t& data, callback_t<json_t> callback) const
+            {
+                json_t json;
+
+                try
+                {
+                    json = json_t::parse("{"+data+"}");
+                }
+                catch(...)
+                {
+                    return callback(json_t{}, std::current_exception());
+                }
+
+                requestPostAsync(adr, json, std::move(callback));
+            }
+
+            void requestPostAsync(string_t adr, const json_t& data, callback_t<json_t> callback) const
+            {
+                if(adr.empty())
+                    return callback(json_t{}, std::make_exception_ptr(iolink::utils::exception_argument(__func__, "Address argument must be non empty string")));
+
+                if(m_parent)
+                    return m_root->requestPostAsync(m_address+adr, data, std::move(callback));
+
+                if(!m_comm)
+                    return callback(json_t{}, std::make_exception_ptr(iolink::utils::exception_logic(__func__, "Communication object not set")));
+
                 json_t request;
                 request["cid"]  = -1;
                 request["code"] = "request";
@@ -116,13 +321,123 @@ namespace iolink::iot
                     request["data"] = data;
                 m_comm->applySecurityToRequestObject(request);
 
-                return checkResponseCode(json_t::parse(m_comm->httpPost(request.dump())));
+                m_comm->httpPostAsync(request.dump(), makeResponseHandler(std::move(callback)));
             }
 
         private:
-            const json_t& checkResponseCode(const json_t& response) const
+            const BaseElement& root() const
+            {
+                return *m_root;
+            }
+
+            // Must be called on the root element
+            string_t httpGetRequest(const RequestTemplate& request) const
+            {
+                if(!m_comm)
+                    throw iolink::utils::exception_logic(__func__, "Communication object not set");
+
+                if(m_comm->isSecurityMode())
+                    return httpPostRequest(request, {});
+
+                return m_comm->httpGet(request.adr());
+            }
+
+            // Must be called on the root element
+            string_t httpPostRequest(const RequestTemplate& request, std::string_view data) const
+            {
+                if(!m_comm)
+                    throw iolink::utils::exception_logic(__func__, "Communication object not set");
+
+                if(!m_comm->isSecurityMode() && data.empty())
+                    return m_comm->httpPost(request.body());
+
+                return m_comm->httpPost(request.body(m_comm->authJson(), data));
+            }
+
+            // Must be called on the root element
+            string_t httpPostRequest(const string_t& adr, const json_t& data) const
             {
-                switch (string_t error = response.contains("error")?response["error"]:""; static_cast<int>(response["code"]))
+                if(!m_comm)
+                    throw iolink::utils::exception_logic(__func__, "Communication object not set");
+
+                json_t request;
+                request["cid"]  = -1;
+                request["code"] = "request";
+                request["adr"]  = adr;
+                if(!data.empty())
+                    request["data"] = data;
+                m_comm->applySecurityToRequestObject(request);
+
+                return m_comm->httpPost(request.dump());
+            }
+
+            template<typename T>
+            static T responseValue(const string_t& response)
+            {
+                ResponseView view{response};
+
+                // Fall back to the DOM for responses the scanner does not recognize
+                if(!view.isValid())
+                    return checkResponseCode(json_t::parse(response))["data"]["value"].template get<T>();
+
+                if(view.code() != 200)
+                    checkResponseCode(view.code(), view.errorString());
+
+                return view.get<T>();
+            }
+
+            static json_t dataMultiRequest(std::vector<string_t> element_urls, bool consistent)
+            {
+                // Erase all empty urls
+                element_urls.erase(remove_if(element_urls.begin(),
+                                             element_urls.end(),
+                                             [](const string_t &el){return el.empty();}),
+                                   element_urls.end()
+                                   );
+
+                if(element_urls.empty()) return json_t{};
+
+                json_t data;
+                data["datatosend"] = element_urls;
+                data["consistent"] = consistent;
+
+                return data;
+            }
+
+            static callback_t<string_t> makeResponseHandler(callback_t<json_t> callback)
+            {
+                return [callback = std::move(callback)](string_t response, std::exception_ptr error)
+                {
+                    if(error)
+                        return callback(json_t{}, error);
+
+                    json_t json;
+
+                    try
+                    {
+                        json = checkResponseCode(json_t::parse(response));
+                    }
+                    catch(...)
+                    {
+                        return callback(json_t{}, std::current_exception());
+                    }
+
+                    callback(std::move(json), nullptr);
+                };
+            }
+
+        public:
+            // Throws the exception matching the "code" of a master response
+            static const json_t& checkResponseCode(const json_t& response)
+            {
+                checkResponseCode(static_cast<int>(response["code"]), response.contains("error")?response["error"]:"");
+
+                return response;
+            }
+
+            static void checkResponseCode(int code, const string_t& error)
+            {
+                switch (code)
                 {
                     case 200: break;
                     case 230: throw utils::exception_master(__func__, utils::exception_master::ErrorCodeType::ERROR_230, error);
@@ -138,14 +453,17 @@ namespace iolink::iot
                     case 532: throw utils::exception_master(__func__, utils::exception_master::ErrorCodeType::ERROR_532, error);
                     default : throw utils::exception_master(__func__, utils::exception_master::ErrorCodeType::BAD_RESPONSE);
                 }
-
-                return response;
             }
 
         protected:
             std::unique_ptr<InterfaceComm> m_comm;
             const BaseElement* const       m_parent;
             const string_t                 m_id;
+
+        private:
+            // The tree does not change after construction, so the root and the address are resolved only once
+            const BaseElement* const       m_root;
+            const string_t                 m_address;
     };
 }
 
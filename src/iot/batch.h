@@ -0,0 +1,185 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "structdevice.h"
+
+namespace iolink::iot
+{
+    template<typename T>
+    class BatchValue;
+
+    /*
+     * Collects the elements to be read and fetches all of them with a single /getdatamulti request.
+     *
+     * Example:
+     *
+     *     iolink::iot::Batch batch{al1352};
+     *     auto pdin   = batch.add(al1352.iolinkmaster.port1.iolinkdevice.pdin);
+     *     auto status = batch.add(al1352.iolinkmaster.port1.iolinkdevice.status);
+     *     batch.execute();
+     *     auto value  = pdin.get();
+     *
+     * The batch can be executed many times. Every execution refreshes the values of all the collected elements.
+     */
+    class Batch
+    {
+        public:
+            explicit Batch(const StructDevice &device, bool consistent = false):
+                m_device{device},
+                m_consistent{consistent}
+            {}
+
+            template<typename Element>
+            BatchValue<typename Element::type_t> add(const Element &element)
+            {
+                const auto url = element.address();
+
+                auto it = std::find_if(m_entries.begin(), m_entries.end(), [&url](const auto &entry){return entry.first == url;});
+                if(it != m_entries.end())
+                    return BatchValue<typename Element::type_t>{it->second};
+
+                auto response = std::make_shared<json_t>();
+                m_entries.emplace_back(url, response);
+
+                return BatchValue<typename Element::type_t>{response};
+            }
+
+            size_t size() const
+            {
+                return m_entries.size();
+            }
+
+            void clear()
+            {
+                m_entries.clear();
+            }
+
+            void execute() const
+            {
+                distribute(m_entries, m_device.getDataMulti(urls(), m_consistent));
+            }
+
+            // The values must not be accessed until the callback is invoked
+            void executeAsync(callback_t<void> callback) const
+            {
+                m_device.getDataMultiAsync(urls(), m_consistent, [entries = m_entries, callback = std::move(callback)](json_t response, std::exception_ptr error)
+                {
+                    if(!error)
+                    {
+                        try
+                        {
+                            distribute(entries, response);
+                        }
+                        catch(...)
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+
+                    callback(error);
+                });
+            }
+
+            std::future<void> executeAsync() const
+            {
+                auto [future, callback] = utils::makeFutureCallback<void>();
+                executeAsync(std::move(callback));
+                return std::move(future);
+            }
+
+        private:
+            using entries_t = std::vector<std::pair<string_t, std::shared_ptr<json_t>>>;
+
+            std::vector<string_t> urls() const
+            {
+                std::vector<string_t> element_urls;
+                element_urls.reserve(m_entries.size());
+
+                for(const auto &entry: m_entries)
+                    element_urls.push_back(entry.first);
+
+                return element_urls;
+            }
+
+            static void distribute(const entries_t &entries, const json_t &response)
+            {
+                if(entries.empty())
+                    return;
+
+                const auto &data = response.at("data");
+
+                // Every entry gets its own response code, so one failed element does not fail the whole batch
+                for(const auto &[url, value]: entries)
+                {
+                    if(auto it = data.find(url); it != data.end())
+                        *value = *it;
+                    else
+                        *value = json_t{{"code", -1}};
+                }
+            }
+
+        private:
+            const StructDevice &m_device;
+            const bool          m_consistent;
+            entries_t           m_entries;
+    };
+
+    // Typed result of an element added to a Batch
+    template<typename T>
+    class BatchValue
+    {
+        public:
+            using type_t = T;
+
+            // True after the batch was executed
+            bool isReady() const
+            {
+                return !m_response->is_null();
+            }
+
+            T get() const
+            {
+                if(!isReady())
+                    throw iolink::utils::exception_logic(__func__, "Batch not executed");
+
+                return BaseElement::checkResponseCode(*m_response)["data"].template get<T>();
+            }
+
+            json_t getJson() const
+            {
+                return *m_response;
+            }
+
+        private:
+            friend class Batch;
+
+            explicit BatchValue(std::shared_ptr<const json_t> response):
+                m_response{std::move(response)}
+            {}
+
+        private:
+            std::shared_ptr<const json_t> m_response;
+    };
+}
+
+#endif // BATCH_H
@@ -0,0 +1,340 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BLOBTRANSFER_H
+#define BLOBTRANSFER_H
+
+#include "profileblob.h"
+#include "../checksum.h"
+
+#include <chrono>
+#include <condition_variable>
+
+namespace iolink::iot
+{
+    // Progress of a blob transfer
+    struct TransferProgress
+    {
+        uint64_t                       transferred = 0;  // Bytes
+        uint64_t                       total       = 0;  // Bytes
+        std::chrono::duration<double>  elapsed{0};
+
+        // Bytes per second
+        double throughput() const
+        {
+            return elapsed.count() > 0 ? static_cast<double>(transferred) / elapsed.count() : 0;
+        }
+    };
+
+    using progress_t = std::function<void(const TransferProgress&)>;
+
+    namespace detail
+    {
+        template<typename Blob, typename = void>
+        struct HasCRC: std::false_type{};
+
+        template<typename Blob>
+        struct HasCRC<Blob, std::void_t<decltype(std::declval<const Blob&>().getCRC())>>: std::true_type{};
+
+        template<typename Blob, typename = void>
+        struct HasMD5: std::false_type{};
+
+        template<typename Blob>
+        struct HasMD5<Blob, std::void_t<decltype(std::declval<const Blob&>().getMD5())>>: std::true_type{};
+
+        // The value is either the data itself or its "value" member
+        inline const json_t& blobValue(const json_t &response)
+        {
+            const json_t &data = response.at("data");
+            return (data.is_object() && data.contains("value")) ? data["value"] : data;
+        }
+
+        // The checksum is a number or a hex string
+        inline string_t checksumString(const json_t &response)
+        {
+            const json_t &value = blobValue(response);
+
+            if(value.is_number_unsigned())
+                return utils::hexEncode(value.get<uint32_t>());
+
+            string_t hex = value.get<string_t>();
+
+            if(hex.size() > 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X'))
+                hex.erase(0, 2);
+
+            for(auto &ch: hex)
+                ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+
+            return hex;
+        }
+
+        // Compares the content of the blob with the data, using every check the blob supports
+        template<typename Blob>
+        void verifyBlob(const Blob &blob, const uint8_t *data, size_t size)
+        {
+            if(static_cast<uint64_t>(blob.size.getData()) != size)
+                throw iolink::utils::exception_master(__func__, iolink::utils::exception_master::ErrorCodeType::BAD_RESPONSE, "Blob size does not match");
+
+            if constexpr(HasCRC<Blob>::value)
+            {
+                auto crc = checksumString(blob.getCRC());
+                crc.insert(0, crc.size() < 8 ? 8 - crc.size() : 0, '0');
+
+                if(crc != utils::hexEncode(utils::crc32(data, size)))
+                    throw iolink::utils::exception_master(__func__, iolink::utils::exception_master::ErrorCodeType::BAD_RESPONSE, "Blob CRC does not match");
+            }
+
+            if constexpr(HasMD5<Blob>::value)
+            {
+                const auto digest = utils::Md5::digest(data, size);
+
+                if(checksumString(blob.getMD5()) != utils::hexEncode(string_t(digest.begin(), digest.end())))
+                    throw iolink::utils::exception_master(__func__, iolink::utils::exception_master::ErrorCodeType::BAD_RESPONSE, "Blob MD5 does not match");
+            }
+        }
+    }
+
+    /*
+     * Streams the data into the blob in chunks of the size reported by the blob and verifies the result. The next chunk
+     * is encoded while the previous one is in flight. The progress is reported after every chunk.
+     *
+     * The size of the blob is always verified, the CRC and the MD5 only if the blob provides getCRC() and getMD5().
+     */
+    template<typename Blob>
+    void uploadBlob(const Blob &blob, const uint8_t *data, size_t size, const progress_t &progress = nullptr)
+    {
+        // Multiple of three, so the chunks are encoded without padding
+        const size_t chunk_size = static_cast<size_t>(std::max<int64_t>(blob.chunksize.getData(), 0)) / 3 * 3;
+
+        if(chunk_size == 0)
+            throw iolink::utils::exception_master(__func__, iolink::utils::exception_master::ErrorCodeType::BAD_RESPONSE, "Invalid chunk size");
+
+        blob.startStreamSet(size);
+
+        const auto start = std::chrono::steady_clock::now();
+
+        auto encode = [data, size, chunk_size](size_t offset, string_t &output)
+        {
+            const size_t length = std::min(chunk_size, size - offset);
+
+            output.resize(utils::base64EncodedLength(length));
+            utils::base64Encode(data + offset, length, output.data());
+        };
+
+        string_t current, next;
+
+        if(size)
+            encode(0, current);
+
+        for(size_t offset = 0; offset < size;)
+        {
+            const size_t length = std::min(chunk_size, size - offset);
+
+            auto [future, callback] = utils::makeFutureCallback<json_t>();
+            blob.streamSetAsync(current, std::move(callback));
+
+            if(offset + length < size)
+                encode(offset + length, next);
+
+            future.get();
+
+            offset += length;
+            std::swap(current, next);
+
+            if(progress)
+                progress(TransferProgress{offset, size, std::chrono::steady_clock::now() - start});
+        }
+
+        detail::verifyBlob(blob, data, size);
+    }
+
+    /*
+     * Reads the whole blob into the output, which must hold "size" bytes, usually the value of blob.size. The ranges
+     * of chunksize bytes are requested with up to "in_flight" requests at the same time and every range is decoded
+     * straight into its place in the output. The progress is reported as the ranges complete.
+     *
+     * The content is verified with getMD5() if the blob provides it.
+     */
+    template<typename Blob>
+    void downloadBlob(const Blob &blob, uint8_t *output, size_t size, size_t in_flight = 4, const progress_t &progress = nullptr)
+    {
+        const size_t chunk_size = static_cast<size_t>(std::max<int64_t>(blob.chunksize.getData(), 0));
+
+        if(chunk_size == 0)
+            throw iolink::utils::exception_master(__func__, iolink::utils::exception_master::ErrorCodeType::BAD_RESPONSE, "Invalid chunk size");
+
+        if(in_flight == 0)
+            throw iolink::utils::exception_argument(__func__, "At least one request must be in flight");
+
+        struct State
+        {
+            std::mutex               mutex;
+            std::condition_variable  cv;
+            size_t                   active      = 0;
+            uint64_t                 transferred = 0;
+            std::exception_ptr       error;
+        };
+
+        auto state = std::make_shared<State>();
+        const auto start = std::chrono::steady_clock::now();
+        uint64_t reported = 0;
+
+        /*
+         * Waits until the predicate holds and reports the progress made in the meantime. An exception thrown by the
+         * progress callback fails the transfer like a failed request. It must not unwind from here, because the
+         * requests in flight keep writing to the output until they complete
+         */
+        auto wait = [&](auto predicate)
+        {
+            std::unique_lock lock{state->mutex};
+
+            for(;;)
+            {
+                state->cv.wait(lock, [&]{return predicate() || state->transferred != reported;});
+
+                if(progress && !state->error && state->transferred != reported)
+                {
+                    reported = state->transferred;
+                    lock.unlock();
+
+                    std::exception_ptr error;
+
+                    try
+                    {
+                        progress(TransferProgress{reported, size, std::chrono::steady_clock::now() - start});
+                    }
+                    catch(...)
+                    {
+                        error = std::current_exception();
+                    }
+
+                    lock.lock();
+
+                    if(error && !state->error)
+                        state->error = error;
+                }
+                else
+                    reported = state->transferred;
+
+                if(predicate())
+                    return;
+            }
+        };
+
+        for(size_t offset = 0; offset < size; offset += chunk_size)
+        {
+            wait([&]{return state->active < in_flight || state->error;});
+
+            {
+                std::lock_guard lock{state->mutex};
+
+                if(state->error)
+                    break;
+
+                ++state->active;
+            }
+
+            const size_t length = std::min(chunk_size, size - offset);
+
+            auto complete = [state, length](std::exception_ptr error)
+            {
+                {
+                    std::lock_guard lock{state->mutex};
+
+                    if(error && !state->error)
+                        state->error = error;
+
+                    if(!error)
+                        state->transferred += length;
+
+                    --state->active;
+                }
+
+                state->cv.notify_all();
+            };
+
+            try
+            {
+                blob.getBlobDataAsync(static_cast<uint32_t>(offset), static_cast<uint32_t>(length), [complete, destination = output + offset, length](json_t response, std::exception_ptr error)
+                {
+                    if(!error)
+                    {
+                        try
+                        {
+                            const auto &value = detail::blobValue(response).template get_ref<const string_t&>();
+
+                            // The padding of the last block must not be written past the range
+                            size_t decoded;
+                            if(utils::base64DecodedLength(value.size()) <= length)
+                                decoded = utils::base64Decode(value.data(), value.size(), destination);
+                            else
+                            {
+                                vector_t buffer(utils::base64DecodedLength(value.size()));
+                                decoded = utils::base64Decode(value.data(), value.size(), buffer.data());
+
+                                if(decoded == length)
+                                    std::copy(buffer.begin(), buffer.begin() + length, destination);
+                            }
+
+                            if(decoded != length)
+                                throw iolink::utils::exception_master(__func__, iolink::utils::exception_master::ErrorCodeType::BAD_RESPONSE, "Blob range has wrong length");
+                        }
+                        catch(...)
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+
+                    complete(error);
+                });
+            }
+            catch(...)
+            {
+                complete(std::current_exception());
+            }
+        }
+
+        // Also after a failure, every request in flight must complete before the output is released
+        wait([&]{return state->active == 0;});
+
+        if(state->error)
+            std::rethrow_exception(state->error);
+
+        if constexpr(detail::HasMD5<Blob>::value)
+        {
+            const auto digest = utils::Md5::digest(output, size);
+
+            if(detail::checksumString(blob.getMD5()) != utils::hexEncode(string_t(digest.begin(), digest.end())))
+                throw iolink::utils::exception_master(__func__, iolink::utils::exception_master::ErrorCodeType::BAD_RESPONSE, "Blob MD5 does not match");
+        }
+    }
+
+    // Reads the whole blob into memory
+    template<typename Blob>
+    vector_t downloadBlob(const Blob &blob, size_t in_flight = 4, const progress_t &progress = nullptr)
+    {
+        vector_t output(static_cast<size_t>(std::max<int64_t>(blob.size.getData(), 0)));
+        downloadBlob(blob, output.data(), output.size(), in_flight, progress);
+
+        return output;
+    }
+}
+
+#endif // BLOBTRANSFER_H
@@ -0,0 +1,391 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+/*
+ * C++20 coroutine front-end for the asynchronous API. It is available only when the compiler supports coroutines,
+ * which is signaled by IOLINK_COROUTINES. The C++17 blocking API is not affected by this header.
+ *
+ * Example:
+ *
+ *     iolink::co::Task<uint16_t> readDistance(const O1D105 &drv, iolink::iot::EventLoop &loop)
+ *     {
+ *         co_return co_await iolink::co::read(drv.dS1, loop);
+ *     }
+ */
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#define IOLINK_COROUTINES 1
+
+#include <atomic>
+#include <coroutine>
+#include <optional>
+
+#include "executor.h"
+#include "datatype.h"
+
+namespace iolink::co
+{
+    using iolink::iot::InterfaceExecutor;
+    using iolink::iot::InlineExecutor;
+
+    /*
+     * Suspends the coroutine until the asynchronous operation completes. The coroutine is resumed through the
+     * executor, or without suspending at all if the operation completes synchronously.
+     */
+    template<typename T>
+    class Awaitable
+    {
+        public:
+            using starter_t = std::function<void(callback_t<T>)>;
+
+            Awaitable(starter_t start, InterfaceExecutor &executor):
+                m_start{std::move(start)},
+                m_executor{executor}
+            {}
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle)
+            {
+                m_handle = handle;
+
+                // The coroutine frame holding this object may be destroyed as soon as the callback is invoked
+                auto start = std::move(m_start);
+
+                if constexpr(std::is_void_v<T>)
+                    start([this](std::exception_ptr error)
+                    {
+                        m_error = error;
+                        complete();
+                    });
+                else
+                    start([this](T value, std::exception_ptr error)
+                    {
+                        if(!error)
+                            m_value.emplace(std::move(value));
+
+                        m_error = error;
+                        complete();
+                    });
+
+                // The first one to get here, the callback or the coroutine, does not resume
+                return !m_ready.exchange(true);
+            }
+
+            T await_resume()
+            {
+                if(m_error)
+                    std::rethrow_exception(m_error);
+
+                if constexpr(!std::is_void_v<T>)
+                    return std::move(*m_value);
+            }
+
+        private:
+            void complete()
+            {
+                if(m_ready.exchange(true))
+                    m_executor.post([handle = m_handle]{handle.resume();});
+            }
+
+        private:
+            using value_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+            starter_t               m_start;
+            InterfaceExecutor&      m_executor;
+            std::coroutine_handle<> m_handle;
+            std::optional<value_t>  m_value;
+            std::exception_ptr      m_error;
+            std::atomic<bool>       m_ready{false};
+    };
+
+    template<typename Element>
+    Awaitable<typename Element::type_t> getData(const Element &element, InterfaceExecutor &executor = InlineExecutor::instance())
+    {
+        return {[&element](callback_t<typename Element::type_t> callback){element.getDataAsync(std::move(callback));}, executor};
+    }
+
+    template<typename Parameter>
+    Awaitable<typename Parameter::type_t> read(const Parameter &parameter, InterfaceExecutor &executor = InlineExecutor::instance())
+    {
+        return {[&parameter](callback_t<typename Parameter::type_t> callback){parameter.readAsync(std::move(callback));}, executor};
+    }
+
+    template<typename Parameter>
+    Awaitable<void> write(const Parameter &parameter, typename Parameter::type_t value, InterfaceExecutor &executor = InlineExecutor::instance())
+    {
+        return {[&parameter, value = std::move(value)](callback_t<void> callback){parameter.writeAsync(value, std::move(callback));}, executor};
+    }
+
+    inline Awaitable<json_t> subscribe(const iot::DataEvent &event, const string_t &callback_url, std::vector<string_t> element_urls, InterfaceExecutor &executor = InlineExecutor::instance())
+    {
+        return {[&event, callback_url, element_urls = std::move(element_urls)](callback_t<json_t> callback){event.subscribeAsync(callback_url, element_urls, std::move(callback));}, executor};
+    }
+
+    /*
+     * Minimal lazily started coroutine type. A Task starts when it is awaited by another coroutine or when it is
+     * passed to spawn().
+     */
+    template<typename T = void>
+    class Task;
+
+    namespace detail
+    {
+        template<typename T>
+        struct TaskPromiseBase
+        {
+            std::coroutine_handle<> continuation;
+            std::exception_ptr      error;
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            auto final_suspend() noexcept
+            {
+                struct FinalAwaiter
+                {
+                    bool await_ready() noexcept
+                    {
+                        return false;
+                    }
+
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<>) noexcept
+                    {
+                        return continuation ? continuation : std::noop_coroutine();
+                    }
+
+                    void await_resume() noexcept
+                    {
+                    }
+
+                    std::coroutine_handle<> continuation;
+                };
+
+                return FinalAwaiter{continuation};
+            }
+
+            void unhandled_exception()
+            {
+                error = std::current_exception();
+            }
+        };
+
+        template<typename T>
+        struct TaskPromise: TaskPromiseBase<T>
+        {
+            std::optional<T> value;
+
+            Task<T> get_return_object();
+
+            void return_value(T result)
+            {
+                value.emplace(std::move(result));
+            }
+
+            T result()
+            {
+                if(this->error)
+                    std::rethrow_exception(this->error);
+
+                return std::move(*value);
+            }
+        };
+
+        template<>
+        struct TaskPromise<void>: TaskPromiseBase<void>
+        {
+            Task<void> get_return_object();
+
+            void return_void()
+            {
+            }
+
+            void result()
+            {
+                if(this->error)
+                    std::rethrow_exception(this->error);
+            }
+        };
+    }
+
+    template<typename T>
+    class Task
+    {
+        public:
+            using promise_type = detail::TaskPromise<T>;
+            using handle_t     = std::coroutine_handle<promise_type>;
+
+            Task(const Task&) =delete;
+            Task& operator= (const Task&) =delete;
+
+            Task(Task&& other) noexcept:
+                m_handle{std::exchange(other.m_handle, nullptr)}
+            {}
+
+            Task& operator= (Task&& other) noexcept
+            {
+                if(this != &other)
+                {
+                    if(m_handle)
+                        m_handle.destroy();
+
+                    m_handle = std::exchange(other.m_handle, nullptr);
+                }
+
+                return *this;
+            }
+
+            ~Task()
+            {
+                if(m_handle)
+                    m_handle.destroy();
+            }
+
+            bool await_ready() const noexcept
+            {
+                return !m_handle || m_handle.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+            {
+                m_handle.promise().continuation = continuation;
+                return m_handle;
+            }
+
+            T await_resume()
+            {
+                return m_handle.promise().result();
+            }
+
+        private:
+            friend promise_type;
+
+            explicit Task(handle_t handle):
+                m_handle{handle}
+            {}
+
+        private:
+            handle_t m_handle;
+    };
+
+    namespace detail
+    {
+        template<typename T>
+        Task<T> TaskPromise<T>::get_return_object()
+        {
+            return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+        }
+
+        inline Task<void> TaskPromise<void>::get_return_object()
+        {
+            return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+        }
+
+        // Eagerly started coroutine that destroys itself on completion
+        struct Detached
+        {
+            struct promise_type
+            {
+                Detached get_return_object() noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never initial_suspend() noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never final_suspend() noexcept
+                {
+                    return {};
+                }
+
+                void return_void() noexcept
+                {
+                }
+
+                void unhandled_exception() noexcept
+                {
+                    std::terminate();
+                }
+            };
+        };
+
+        template<typename T>
+        Detached runDetached(Task<T> task, std::shared_ptr<std::promise<T>> promise)
+        {
+            try
+            {
+                if constexpr(std::is_void_v<T>)
+                {
+                    co_await task;
+                    promise->set_value();
+                }
+                else
+                    promise->set_value(co_await task);
+            }
+            catch(...)
+            {
+                promise->set_exception(std::current_exception());
+            }
+        }
+    }
+
+    // Starts a top level task on the calling thread. The result is available through the returned future
+    template<typename T>
+    std::future<T> spawn(Task<T> task)
+    {
+        auto promise = std::make_shared<std::promise<T>>();
+        auto future  = promise->get_future();
+
+        detail::runDetached(std::move(task), std::move(promise));
+
+        return future;
+    }
+
+    // Starts a top level task from the executor
+    template<typename T>
+    std::future<T> spawn(Task<T> task, InterfaceExecutor &executor)
+    {
+        auto promise = std::make_shared<std::promise<T>>();
+        auto future  = promise->get_future();
+
+        executor.post([task = std::make_shared<Task<T>>(std::move(task)), promise]() mutable
+        {
+            detail::runDetached(std::move(*task), std::move(promise));
+        });
+
+        return future;
+    }
+}
+
+#endif // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#endif // COROUTINE_H
@@ -32,10 +32,11 @@ namespace iolink::iot
             template<typename ...CArgs>
             AccessRead(const string_t& id, BaseElement* parent, CArgs&& ... cargs):
                 DataType{id, parent, std::forward<CArgs>(cargs) ...},
-                Args{id, parent}...
+                Args{id, parent}...,
+                m_getdata{DataType::requestTemplate("/getdata")}
             {}
 
-            string_t address() const override
+            const string_t& address() const override
             {
                 return DataType::address();
             }
@@ -47,13 +48,45 @@ namespace iolink::iot
 
             json_t getDataJson() const
             {
-                return DataType::requestGet("/getdata");
+                return DataType::requestGet(m_getdata);
             }
 
             typename DataType::type_t getData() const
             {
-                return DataType::requestGet("/getdata")["data"]["value"];
+                return DataType::template requestGetValue<typename DataType::type_t>(m_getdata);
             }
+
+            void getDataAsync(callback_t<typename DataType::type_t> callback) const
+            {
+                DataType::requestGetAsync(m_getdata, [callback = std::move(callback)](json_t response, std::exception_ptr error)
+                {
+                    typename DataType::type_t value{};
+
+                    if(!error)
+                    {
+                        try
+                        {
+                            value = response["data"]["value"].template get<typename DataType::type_t>();
+                        }
+                        catch(...)
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+
+                    callback(std::move(value), error);
+                });
+            }
+
+            std::future<typename DataType::type_t> getDataAsync() const
+            {
+                auto [future, callback] = utils::makeFutureCallback<typename DataType::type_t>();
+                getDataAsync(std::move(callback));
+                return std::move(future);
+            }
+
+        private:
+            const RequestTemplate m_getdata;
     };
 
     template<typename DataType, typename ...Args>
@@ -63,10 +96,11 @@ namespace iolink::iot
             template<typename ...CArgs>
             AccessReadWrite(const string_t& id, BaseElement* parent, CArgs&& ... cargs):
                 DataType{id, parent, std::forward<CArgs>(cargs) ...},
-                Args{id, parent}...
+                Args{id, parent}...,
+                m_getdata{DataType::requestTemplate("/getdata")}
             {}
 
-            string_t address() const override
+            const string_t& address() const override
             {
                 return DataType::address();
             }
@@ -78,21 +112,76 @@ namespace iolink::iot
 
             json_t getDataJson() const
             {
-                return DataType::requestGet("/getdata");
+                return DataType::requestGet(m_getdata);
             }
 
             typename DataType::type_t getData() const
             {
-                return DataType::requestGet("/getdata")["data"]["value"];
+                return DataType::template requestGetValue<typename DataType::type_t>(m_getdata);
+            }
+
+            void getDataAsync(callback_t<typename DataType::type_t> callback) const
+            {
+                DataType::requestGetAsync(m_getdata, [callback = std::move(callback)](json_t response, std::exception_ptr error)
+                {
+                    typename DataType::type_t value{};
+
+                    if(!error)
+                    {
+                        try
+                        {
+                            value = response["data"]["value"].template get<typename DataType::type_t>();
+                        }
+                        catch(...)
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+
+                    callback(std::move(value), error);
+                });
             }
 
-            json_t setData(typename DataType::type_t value) const
+            std::future<typename DataType::type_t> getDataAsync() const
+            {
+                auto [future, callback] = utils::makeFutureCallback<typename DataType::type_t>();
+                getDataAsync(std::move(callback));
+                return std::move(future);
+            }
+
+            json_t setData(const typename DataType::type_t &value) const
+            {
+                return DataType::requestPost(m_setdata, setDataBody(value));
+            }
+
+            void setDataAsync(const typename DataType::type_t &value, callback_t<json_t> callback) const
+            {
+                DataType::requestPostAsync(m_setdata, setDataBody(value), std::move(callback));
+            }
+
+            std::future<json_t> setDataAsync(const typename DataType::type_t &value) const
+            {
+                auto [future, callback] = utils::makeFutureCallback<json_t>();
+                setDataAsync(value, std::move(callback));
+                return std::move(future);
+            }
+
+        private:
+            string_t setDataBody(const typename DataType::type_t &value) const
             {
                 if(!this->isValid(value))
                     throw iolink::utils::exception_argument(__func__, "Trying to set an invalid value");
 
-                return DataType::requestPost("/setdata", R"("newvalue":")" + std::to_string(value) + R"(")");
+                // Numbers are sent as strings, as the master expects them
+                if constexpr(std::is_arithmetic_v<typename DataType::type_t>)
+                    return R"({"newvalue":")" + std::to_string(value) + R"("})";
+                else
+                    return R"({"newvalue":)" + json_t(value).dump() + "}";
             }
+
+        private:
+            const RequestTemplate m_getdata;
+            const RequestTemplate m_setdata{DataType::requestTemplate("/setdata")};
     };
 
 
@@ -50,6 +50,26 @@ namespace iolink::iot
                 return requestPost("/subscribe", data);
             }
 
+            void subscribeAsync(const string_t &callback_url, std::vector<string_t> element_urls, callback_t<json_t> callback) const
+            {
+                // Erase all empty urls
+                element_urls.erase(remove_if(element_urls.begin(), element_urls.end(),
+                                             [](const string_t &el){return el.empty();}),
+                                   element_urls.end());
+
+                if(callback_url.empty())
+                    return callback(json_t{}, std::make_exception_ptr(iolink::utils::exception_argument(__func__, "Callback urls can not be empty")));
+
+                if(element_urls.empty())
+                    return callback(json_t{}, std::make_exception_ptr(iolink::utils::exception_argument(__func__, "Element urls can not be empty")));
+
+                json_t data;
+                data["callback"] = callback_url;
+                data["data"] = element_urls;
+
+                requestPostAsync("/subscribe", data, std::move(callback));
+            }
+
             json_t unsubscribe(const string_t &callback_url) const
             {
                 if(callback_url.empty())
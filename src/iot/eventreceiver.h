@@ -0,0 +1,320 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef EVENTRECEIVER_H
+#define EVENTRECEIVER_H
+
+#include "socket.h"
+#include "base.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace iolink::iot
+{
+    /*
+     * Embedded HTTP server receiving the notifications the master posts to the callback url of a DataEvent
+     * subscription. Every notification carries the values of the subscribed elements, which are dispatched to the
+     * handlers registered for them.
+     *
+     * Example:
+     *
+     *     iolink::iot::EventReceiver receiver{"192.168.1.10"};
+     *     receiver.on(al1352.timer1.counter, [](int64_t value, std::exception_ptr error){});
+     *     receiver.start();
+     *
+     *     al1352.timer1.counter.subscribe(receiver.callbackUrl(), {al1352.timer1.counter.address()});
+     *
+     * The handlers are invoked from the thread calling poll(), which is the internal thread after start(). Whatever a
+     * handler throws is passed to iolink::utils::reportUnhandledException() and the remaining entries are dispatched.
+     */
+    class EventReceiver
+    {
+        public:
+            // The ip must be the address of the local interface reachable by the master. Port 0 selects a free port
+            explicit EventReceiver(const string_t &ip, uint16_t port = 0):
+                m_ip{ip},
+                m_listener{Socket::listen(ip, port)}
+            {
+                if(::pipe(m_wake) != 0)
+                    throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_IO, std::strerror(errno));
+
+                for(auto fd: m_wake)
+                    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+            }
+
+            EventReceiver(const EventReceiver&) =delete;
+            EventReceiver(EventReceiver&&) =delete;
+            EventReceiver& operator= (const EventReceiver&) =delete;
+            EventReceiver& operator= (EventReceiver&&) =delete;
+
+            ~EventReceiver()
+            {
+                stop();
+
+                for(auto fd: m_wake)
+                    ::close(fd);
+            }
+
+            uint16_t port() const
+            {
+                return m_listener.localPort();
+            }
+
+            // The url to be passed to DataEvent::subscribe()
+            string_t callbackUrl() const
+            {
+                return callbackUrl(m_ip);
+            }
+
+            // Use it when listening on all interfaces (0.0.0.0)
+            string_t callbackUrl(const string_t &host) const
+            {
+                return "http://"+host+":"+std::to_string(port())+"/";
+            }
+
+            // Registers a handler for the raw {"code":..., "data":...} entry of an element url
+            void on(const string_t &url, callback_t<json_t> handler)
+            {
+                if(url.empty())
+                    throw iolink::utils::exception_argument(__func__, "Element url can not be empty");
+
+                std::lock_guard lock{m_mutex};
+                m_handlers[url] = std::move(handler);
+            }
+
+            // Registers a typed handler for an element. The handler receives an error if the master reports one
+            template<typename Element>
+            void on(const Element &element, callback_t<typename Element::type_t> handler)
+            {
+                on(element.address(), [handler = std::move(handler)](json_t entry, std::exception_ptr error)
+                {
+                    typename Element::type_t value{};
+
+                    if(!error)
+                    {
+                        try
+                        {
+                            value = BaseElement::checkResponseCode(entry)["data"].template get<typename Element::type_t>();
+                        }
+                        catch(...)
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+
+                    handler(std::move(value), error);
+                });
+            }
+
+            void off(const string_t &url)
+            {
+                std::lock_guard lock{m_mutex};
+                m_handlers.erase(url);
+            }
+
+            template<typename Element>
+            void off(const Element &element)
+            {
+                off(element.address());
+            }
+
+            /*
+             * Accepts connections, receives the notifications and dispatches them. Waits up to timeout for
+             * something to happen. Must not be called while the receiver is started.
+             */
+            void poll(milliseconds_t timeout)
+            {
+                std::vector<pollfd> fds;
+                fds.reserve(m_connections.size() + 2);
+                fds.push_back({m_wake[0], POLLIN, 0});
+                fds.push_back({m_listener.fd(), POLLIN, 0});
+                for(const auto &connection: m_connections)
+                    fds.push_back({connection.socket.fd(), POLLIN, 0});
+
+                if(::poll(fds.data(), fds.size(), static_cast<int>(std::max<milliseconds_t::rep>(timeout.count(), 0))) <= 0)
+                    return;
+
+                if(fds[0].revents)
+                {
+                    char buffer[64];
+                    while(::read(m_wake[0], buffer, sizeof(buffer)) > 0);
+                }
+
+                // Only the connections that were polled are processed. The new ones are added after them
+                std::vector<Connection> connections;
+                connections.reserve(m_connections.size());
+
+                for(size_t i = 0; i < m_connections.size(); ++i)
+                {
+                    auto &connection = m_connections[i];
+
+                    try
+                    {
+                        if(!fds[i + 2].revents || receive(connection))
+                            connections.push_back(std::move(connection));
+                    }
+                    catch(const iolink::utils::exception_comm&)
+                    {
+                        // A broken connection is dropped. The master opens a new one for the next notification
+                    }
+                }
+
+                if(fds[1].revents)
+                    for(auto socket = m_listener.accept(); socket.isValid(); socket = m_listener.accept())
+                        connections.push_back(Connection{std::move(socket), HttpParser{true, max_message_size}});
+
+                m_connections = std::move(connections);
+            }
+
+            // Starts an internal thread which calls poll()
+            void start()
+            {
+                if(m_thread.joinable())
+                    return;
+
+                m_stop = false;
+                m_thread = std::thread{[this]
+                {
+                    while(!m_stop)
+                        poll(milliseconds_t{-1});
+                }};
+            }
+
+            void stop()
+            {
+                if(!m_thread.joinable())
+                    return;
+
+                m_stop = true;
+
+                char byte = 0;
+                [[maybe_unused]] auto result = ::write(m_wake[1], &byte, 1);
+
+                m_thread.join();
+            }
+
+        private:
+            // Limits the header and the body of a notification, so a host can not make the receiver grow its memory
+            static constexpr size_t max_message_size = 64 * 1024;
+
+            struct Connection
+            {
+                Socket     socket;
+                HttpParser parser;
+            };
+
+            // Returns false if the connection must be closed
+            bool receive(Connection &connection)
+            {
+                try
+                {
+                    return receiveMessages(connection);
+                }
+                catch(const iolink::utils::exception_comm &e)
+                {
+                    if(e.error_code() != iolink::utils::exception_comm::ErrorCodeType::ERROR_TOO_LARGE)
+                        throw;
+
+                    connection.socket.sendAll("HTTP/1.1 413 Payload Too Large\r\nContent-Length: 0\r\nConnection: close\r\n\r\n",
+                                              steady_clock_t::now() + milliseconds_t{1000});
+                    return false;
+                }
+            }
+
+            bool receiveMessages(Connection &connection)
+            {
+                for(;;)
+                {
+                    auto received = connection.socket.receive(connection.parser.prepare(4096), 4096);
+
+                    if(received < 0)
+                        return false;
+
+                    if(!connection.parser.commit(static_cast<size_t>(received)))
+                    {
+                        if(received == 0)
+                            return true;
+
+                        continue;
+                    }
+
+                    while(connection.parser.isComplete())
+                    {
+                        auto &message = connection.parser.message();
+                        bool keep_alive = message.keep_alive;
+
+                        connection.socket.sendAll(dispatch(message) ? "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n"
+                                                                    : "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n",
+                                                  steady_clock_t::now() + milliseconds_t{1000});
+
+                        if(!keep_alive)
+                            return false;
+
+                        connection.parser.next();
+                    }
+                }
+            }
+
+            // Returns false if the request is not a notification
+            bool dispatch(const HttpParser::Message &message)
+            {
+                if(message.method != "POST")
+                    return false;
+
+                json_t notification = json_t::parse(message.body, nullptr, false);
+
+                if(notification.is_discarded() || !notification.contains("data") || !notification["data"].contains("payload"))
+                    return false;
+
+                for(auto &[url, entry]: notification["data"]["payload"].items())
+                {
+                    callback_t<json_t> handler;
+
+                    {
+                        std::lock_guard lock{m_mutex};
+
+                        auto it = m_handlers.find(url);
+                        if(it == m_handlers.end())
+                            continue;
+
+                        handler = it->second;
+                    }
+
+                    iolink::utils::invokeGuarded(handler, std::move(entry), nullptr);
+                }
+
+                return true;
+            }
+
+        private:
+            const string_t                         m_ip;
+            Socket                                 m_listener;
+            std::vector<Connection>                m_connections;
+            std::map<string_t, callback_t<json_t>> m_handlers;
+            std::mutex                             m_mutex;
+            std::thread                            m_thread;
+            std::atomic<bool>                      m_stop{false};
+            int                                    m_wake[2] = {-1, -1};  // Self pipe used to interrupt poll()
+    };
+}
+
+#endif // EVENTRECEIVER_H
@@ -0,0 +1,346 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include "../exception.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace iolink::iot
+{
+    /*
+     * Executes the continuations of asynchronous operations. Implement it to integrate the library into an existing
+     * event loop.
+     */
+    class InterfaceExecutor
+    {
+        public:
+            InterfaceExecutor() =default;
+            InterfaceExecutor(const InterfaceExecutor&) =delete;
+            InterfaceExecutor(InterfaceExecutor&&) =delete;
+            InterfaceExecutor& operator= (const InterfaceExecutor&) =delete;
+            InterfaceExecutor& operator= (InterfaceExecutor&&) =delete;
+
+            virtual ~InterfaceExecutor() =default;
+
+            // Must be thread safe. It is called from the thread that completes the request
+            virtual void post(std::function<void()> task) =0;
+    };
+
+    // Runs the task immediately on the calling thread
+    class InlineExecutor final: public InterfaceExecutor
+    {
+        public:
+            void post(std::function<void()> task) override
+            {
+                task();
+            }
+
+            static InlineExecutor& instance()
+            {
+                static InlineExecutor executor;
+                return executor;
+            }
+    };
+
+    // Queue of tasks executed by the thread that calls run()
+    class EventLoop final: public InterfaceExecutor
+    {
+        public:
+            void post(std::function<void()> task) override
+            {
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_tasks.push_back(std::move(task));
+                }
+
+                m_cv.notify_one();
+            }
+
+            // Executes tasks until stop() is called
+            void run()
+            {
+                for(;;)
+                {
+                    std::function<void()> task;
+
+                    {
+                        std::unique_lock lock{m_mutex};
+                        m_cv.wait(lock, [this]{return m_stop || !m_tasks.empty();});
+
+                        if(m_tasks.empty())
+                        {
+                            m_stop = false;
+                            return;
+                        }
+
+                        task = std::move(m_tasks.front());
+                        m_tasks.pop_front();
+                    }
+
+                    task();
+                }
+            }
+
+            // Executes the tasks that are ready without waiting. Returns the number of executed tasks
+            size_t poll()
+            {
+                size_t count = 0;
+
+                for(;;)
+                {
+                    std::function<void()> task;
+
+                    {
+                        std::lock_guard lock{m_mutex};
+
+                        if(m_tasks.empty())
+                            return count;
+
+                        task = std::move(m_tasks.front());
+                        m_tasks.pop_front();
+                    }
+
+                    task();
+                    ++count;
+                }
+            }
+
+            // run() returns once the queued tasks are executed
+            void stop()
+            {
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_stop = true;
+                }
+
+                m_cv.notify_all();
+            }
+
+        private:
+            std::mutex                         m_mutex;
+            std::condition_variable            m_cv;
+            std::deque<std::function<void()>>  m_tasks;
+            bool                               m_stop = false;
+    };
+
+    /*
+     * Fixed number of worker threads executing the tasks in order of submission. Whatever a task throws is passed to
+     * iolink::utils::reportUnhandledException().
+     */
+    class ThreadPool final: public InterfaceExecutor
+    {
+        public:
+            explicit ThreadPool(size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+            {
+                if(threads == 0)
+                    throw iolink::utils::exception_argument(__func__, "Thread pool must have at least one thread");
+
+                m_threads.reserve(threads);
+
+                for(size_t i = 0; i < threads; ++i)
+                    m_threads.emplace_back([this]{work();});
+            }
+
+            // The tasks queued so far are executed before the threads are joined
+            ~ThreadPool() override
+            {
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_stop = true;
+                }
+
+                m_cv.notify_all();
+
+                for(auto &thread: m_threads)
+                    thread.join();
+            }
+
+            void post(std::function<void()> task) override
+            {
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_tasks.push_back(std::move(task));
+                }
+
+                m_cv.notify_one();
+            }
+
+            size_t size() const
+            {
+                return m_threads.size();
+            }
+
+        private:
+            void work()
+            {
+                for(;;)
+                {
+                    std::function<void()> task;
+
+                    {
+                        std::unique_lock lock{m_mutex};
+                        m_cv.wait(lock, [this]{return m_stop || !m_tasks.empty();});
+
+                        if(m_tasks.empty())
+                            return;
+
+                        task = std::move(m_tasks.front());
+                        m_tasks.pop_front();
+                    }
+
+                    // A throwing task must not take the worker thread down
+                    iolink::utils::invokeGuarded(task);
+                }
+            }
+
+        private:
+            std::mutex                         m_mutex;
+            std::condition_variable            m_cv;
+            std::deque<std::function<void()>>  m_tasks;
+            std::vector<std::thread>           m_threads;
+            bool                               m_stop = false;
+    };
+
+    /*
+     * Runs the tasks on another executor, but never more than the limit at the same time. With a limit of one the
+     * tasks are executed one after another in order of submission. The target executor must outlive this one.
+     * Whatever a task throws is passed to iolink::utils::reportUnhandledException().
+     */
+    class LimitedExecutor final: public InterfaceExecutor
+    {
+        public:
+            LimitedExecutor(InterfaceExecutor &executor, size_t limit):
+                m_executor{executor},
+                m_limit{limit}
+            {
+                if(limit == 0)
+                    throw iolink::utils::exception_argument(__func__, "Concurrency limit must be at least one");
+            }
+
+            void post(std::function<void()> task) override
+            {
+                enqueue(Task{std::move(task), nullptr});
+            }
+
+            /*
+             * Starts an asynchronous operation, for example a request of the asynchronous API. The slot stays taken
+             * until the operation calls the completion it receives, so the limit applies to the operations in flight
+             * instead of to the threads. The completion must be called exactly once. If the start throws, the
+             * exception is reported and the completion may be omitted.
+             */
+            void postAsync(std::function<void(std::function<void()>)> start)
+            {
+                enqueue(Task{nullptr, std::move(start)});
+            }
+
+            size_t limit() const
+            {
+                return m_limit;
+            }
+
+        private:
+            struct Task
+            {
+                std::function<void()>                       run;
+                std::function<void(std::function<void()>)>  start;
+            };
+
+            void enqueue(Task task)
+            {
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_tasks.push_back(std::move(task));
+
+                    if(m_running == m_limit)
+                        return;
+
+                    ++m_running;
+                }
+
+                m_executor.post([this]{drain();});
+            }
+
+            // Every running slot keeps executing queued tasks until the queue is empty
+            void drain()
+            {
+                for(;;)
+                {
+                    Task task;
+
+                    {
+                        std::lock_guard lock{m_mutex};
+
+                        if(m_tasks.empty())
+                        {
+                            --m_running;
+                            return;
+                        }
+
+                        task = std::move(m_tasks.front());
+                        m_tasks.pop_front();
+                    }
+
+                    // The slot is released only when the queue is empty, so a throwing task must not leave the loop
+                    if(task.run)
+                    {
+                        iolink::utils::invokeGuarded(task.run);
+                        continue;
+                    }
+
+                    // The slot is handed over to the completion, which resumes draining on the target executor
+                    auto released = std::make_shared<std::atomic<bool>>(false);
+
+                    try
+                    {
+                        task.start([this, released]
+                        {
+                            if(!released->exchange(true))
+                                m_executor.post([this]{drain();});
+                        });
+                    }
+                    catch(...)
+                    {
+                        iolink::utils::reportUnhandledException(std::current_exception());
+
+                        if(!released->exchange(true))
+                            continue;
+                    }
+
+                    return;
+                }
+            }
+
+        private:
+            InterfaceExecutor&  m_executor;
+            const size_t        m_limit;
+            std::mutex          m_mutex;
+            std::deque<Task>    m_tasks;
+            size_t              m_running = 0;
+    };
+}
+
+#endif // EXECUTOR_H
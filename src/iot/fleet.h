@@ -0,0 +1,408 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FLEET_H
+#define FLEET_H
+
+#include "executor.h"
+#include "interfacecomm.h"
+#include "../utils.h"
+
+#include <atomic>
+#include <optional>
+
+namespace iolink::iot
+{
+    // Outcome of an operation of a Fleet on a single master
+    template<typename T>
+    struct FleetResult
+    {
+        using value_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+        std::optional<value_t> value;
+        std::exception_ptr     error;
+
+        bool isOk() const
+        {
+            return value.has_value();
+        }
+
+        // Throws the error of this master, if there is one
+        const value_t& get() const
+        {
+            if(error)
+                std::rethrow_exception(error);
+
+            if(!value)
+                throw iolink::utils::exception_logic(__func__, "Operation not completed");
+
+            return *value;
+        }
+    };
+
+    /*
+     * Owns many masters of the same type and runs operations on all of them in parallel. Every master executes at
+     * most a limited number of operations at the same time, so a slow master does not starve the others and no master
+     * is flooded with requests.
+     *
+     * forEachRequest() starts an asynchronous request on every master and no thread waits for the responses. With a
+     * comm that multiplexes the asynchronous requests, like HttpComm, the whole fleet takes about one round trip:
+     *
+     *     iolink::iot::Fleet<al1352::Device> fleet;
+     *     fleet.add("line1", std::make_unique<iolink::iot::HttpComm>("192.168.1.30"));
+     *     fleet.add("line2", std::make_unique<iolink::iot::HttpComm>("192.168.1.31"));
+     *
+     *     auto temperatures = fleet.forEachRequest<int64_t>([](al1352::Device &device, iolink::callback_t<int64_t> done)
+     *     {
+     *         device.processdatamaster.temperature.getDataAsync(std::move(done));
+     *     });
+     *
+     *     for(const auto &[name, result]: temperatures)
+     *         if(result.isOk())
+     *             std::cout << name << ": " << result.get() << std::endl;
+     *
+     * forEach() runs a blocking function instead, for operations made of several dependent calls. Every call occupies
+     * a thread of the shared pool for its whole round trip, so the pool size bounds the latency: a fleet of 64 masters
+     * on 8 threads takes about 8 round trips.
+     *
+     * Adding and removing masters is not thread safe and must not overlap with running operations.
+     */
+    template<typename Device>
+    class Fleet
+    {
+        public:
+            template<typename Function>
+            using result_t = std::invoke_result_t<Function, Device&>;
+
+            template<typename Function>
+            using results_t = std::map<string_t, FleetResult<result_t<Function>>>;
+
+            template<typename T>
+            using request_results_t = std::map<string_t, FleetResult<T>>;
+
+            /*
+             * The limit applies to every master. Use a limit above one only with a comm that is thread safe. The
+             * threads execute the blocking functions of forEach() and submit(), see the latency note above.
+             */
+            explicit Fleet(size_t threads = std::max(1u, std::thread::hardware_concurrency()), size_t master_limit = 1):
+                m_master_limit{master_limit},
+                m_pool{threads}
+            {
+                if(master_limit == 0)
+                    throw iolink::utils::exception_argument(__func__, "Concurrency limit must be at least one");
+            }
+
+            // Connects to the master on the calling thread
+            Device& add(const string_t &name, std::unique_ptr<InterfaceComm> comm)
+            {
+                if(m_masters.count(name))
+                    throw iolink::utils::exception_argument(__func__, "Master with this name already exists");
+
+                auto &master = m_masters[name];
+
+                try
+                {
+                    master.device = std::make_unique<Device>(std::move(comm));
+                }
+                catch(...)
+                {
+                    m_masters.erase(name);
+                    throw;
+                }
+
+                master.executor = std::make_unique<LimitedExecutor>(m_pool, m_master_limit);
+
+                return *master.device;
+            }
+
+            // Connects to all the masters in parallel. A master that fails to connect is not added and its error is returned
+            std::map<string_t, std::exception_ptr> add(std::map<string_t, std::unique_ptr<InterfaceComm>> comms)
+            {
+                for(const auto &[name, comm]: comms)
+                    if(m_masters.count(name))
+                        throw iolink::utils::exception_argument(__func__, "Master with this name already exists");
+
+                std::vector<std::pair<string_t, std::future<std::unique_ptr<Device>>>> pending;
+                pending.reserve(comms.size());
+
+                for(auto &[name, comm]: comms)
+                {
+                    auto promise = std::make_shared<std::promise<std::unique_ptr<Device>>>();
+                    pending.emplace_back(name, promise->get_future());
+
+                    m_pool.post([promise, comm = std::make_shared<std::unique_ptr<InterfaceComm>>(std::move(comm))]
+                    {
+                        try
+                        {
+                            promise->set_value(std::make_unique<Device>(std::move(*comm)));
+                        }
+                        catch(...)
+                        {
+                            promise->set_exception(std::current_exception());
+                        }
+                    });
+                }
+
+                std::map<string_t, std::exception_ptr> errors;
+
+                for(auto &[name, future]: pending)
+                {
+                    try
+                    {
+                        m_masters[name] = Master{future.get(), std::make_unique<LimitedExecutor>(m_pool, m_master_limit)};
+                    }
+                    catch(...)
+                    {
+                        errors[name] = std::current_exception();
+                    }
+                }
+
+                return errors;
+            }
+
+            void remove(const string_t &name)
+            {
+                m_masters.erase(name);
+            }
+
+            bool contains(const string_t &name) const
+            {
+                return m_masters.count(name) != 0;
+            }
+
+            Device& device(const string_t &name) const
+            {
+                auto it = m_masters.find(name);
+
+                if(it == m_masters.end())
+                    throw iolink::utils::exception_argument(__func__, "No master with this name");
+
+                return *it->second.device;
+            }
+
+            std::vector<string_t> names() const
+            {
+                std::vector<string_t> names;
+                names.reserve(m_masters.size());
+
+                for(const auto &[name, master]: m_masters)
+                    names.push_back(name);
+
+                return names;
+            }
+
+            size_t size() const
+            {
+                return m_masters.size();
+            }
+
+            /*
+             * Runs the function for every master. The callback is invoked with the results of all the masters when
+             * the last one completes. It never receives an error.
+             */
+            template<typename Function>
+            void forEachAsync(Function function, callback_t<results_t<Function>> callback) const
+            {
+                using T = result_t<Function>;
+
+                if(m_masters.empty())
+                    return callback(results_t<Function>{}, nullptr);
+
+                struct State
+                {
+                    State(Function function, size_t pending, callback_t<results_t<Function>> callback):
+                        function{std::move(function)},
+                        pending{pending},
+                        callback{std::move(callback)}
+                    {}
+
+                    Function                         function;
+                    results_t<Function>              results;
+                    std::atomic<size_t>              pending;
+                    callback_t<results_t<Function>>  callback;
+                };
+
+                auto state = std::make_shared<State>(std::move(function), m_masters.size(), std::move(callback));
+
+                // The slots are created upfront, so the tasks do not have to synchronize on the map
+                for(const auto &[name, master]: m_masters)
+                    state->results[name];
+
+                for(const auto &[name, master]: m_masters)
+                {
+                    master.executor->post([state, &device = *master.device, &result = state->results[name]]
+                    {
+                        try
+                        {
+                            if constexpr(std::is_void_v<T>)
+                            {
+                                state->function(device);
+                                result.value.emplace();
+                            }
+                            else
+                                result.value.emplace(state->function(device));
+                        }
+                        catch(...)
+                        {
+                            result.error = std::current_exception();
+                        }
+
+                        if(--state->pending == 0)
+                            state->callback(std::move(state->results), nullptr);
+                    });
+                }
+            }
+
+            template<typename Function>
+            std::future<results_t<Function>> forEachAsync(Function function) const
+            {
+                auto [future, callback] = utils::makeFutureCallback<results_t<Function>>();
+                forEachAsync(std::move(function), std::move(callback));
+                return std::move(future);
+            }
+
+            // Runs the function for every master and waits for all of them
+            template<typename Function>
+            results_t<Function> forEach(Function function) const
+            {
+                return forEachAsync(std::move(function)).get();
+            }
+
+            /*
+             * Starts an asynchronous operation on every master. The function receives the device and the completion
+             * of the operation, which it passes to getDataAsync(), readAsync() or another asynchronous call. The
+             * completion must be invoked exactly once. The concurrency limit of a master counts the operations in
+             * flight. The callback is invoked with the results of all the masters when the last one completes. It never
+             * receives an error.
+             */
+            template<typename T, typename Function>
+            void forEachRequestAsync(Function function, callback_t<request_results_t<T>> callback) const
+            {
+                if(m_masters.empty())
+                    return callback(request_results_t<T>{}, nullptr);
+
+                struct State
+                {
+                    State(Function function, size_t pending, callback_t<request_results_t<T>> callback):
+                        function{std::move(function)},
+                        pending{pending},
+                        callback{std::move(callback)}
+                    {}
+
+                    Function                          function;
+                    request_results_t<T>              results;
+                    std::atomic<size_t>               pending;
+                    callback_t<request_results_t<T>>  callback;
+                };
+
+                auto state = std::make_shared<State>(std::move(function), m_masters.size(), std::move(callback));
+
+                // The slots are created upfront, so the completions do not have to synchronize on the map
+                for(const auto &[name, master]: m_masters)
+                    state->results[name];
+
+                for(const auto &[name, master]: m_masters)
+                {
+                    master.executor->postAsync([state, &device = *master.device, &result = state->results[name]](std::function<void()> release)
+                    {
+                        // The first outcome counts, whether it is the completion or an exception of the start
+                        auto completed = std::make_shared<std::atomic<bool>>(false);
+
+                        auto finish = [state, &result, completed, release = std::move(release)](std::optional<typename FleetResult<T>::value_t> value, std::exception_ptr error)
+                        {
+                            if(completed->exchange(true))
+                                return;
+
+                            if(error)
+                                result.error = error;
+                            else
+                                result.value = std::move(value);
+
+                            release();
+
+                            if(--state->pending == 0)
+                                state->callback(std::move(state->results), nullptr);
+                        };
+
+                        try
+                        {
+                            if constexpr(std::is_void_v<T>)
+                                state->function(device, callback_t<void>{[finish](std::exception_ptr error){finish(std::monostate{}, error);}});
+                            else
+                                state->function(device, callback_t<T>{[finish](T value, std::exception_ptr error){finish(std::move(value), error);}});
+                        }
+                        catch(...)
+                        {
+                            finish(std::nullopt, std::current_exception());
+                        }
+                    });
+                }
+            }
+
+            template<typename T, typename Function>
+            std::future<request_results_t<T>> forEachRequestAsync(Function function) const
+            {
+                auto [future, callback] = utils::makeFutureCallback<request_results_t<T>>();
+                forEachRequestAsync<T>(std::move(function), std::move(callback));
+                return std::move(future);
+            }
+
+            // Starts the operation on every master and waits for all of them
+            template<typename T, typename Function>
+            request_results_t<T> forEachRequest(Function function) const
+            {
+                return forEachRequestAsync<T>(std::move(function)).get();
+            }
+
+            // Runs the function for a single master, respecting its concurrency limit
+            template<typename Function>
+            std::future<result_t<Function>> submit(const string_t &name, Function function) const
+            {
+                auto it = m_masters.find(name);
+
+                if(it == m_masters.end())
+                    throw iolink::utils::exception_argument(__func__, "No master with this name");
+
+                auto task = std::make_shared<std::packaged_task<result_t<Function>()>>([function = std::move(function), &device = *it->second.device]() mutable
+                {
+                    return function(device);
+                });
+
+                auto future = task->get_future();
+                it->second.executor->post([task]{(*task)();});
+
+                return future;
+            }
+
+        private:
+            struct Master
+            {
+                std::unique_ptr<Device>           device;
+                std::unique_ptr<LimitedExecutor>  executor;
+            };
+
+            // The pool is destroyed first, so the queued operations complete while the masters are still alive
+            std::map<string_t, Master>  m_masters;
+            const size_t                m_master_limit;
+            ThreadPool                  m_pool;
+    };
+}
+
+#endif // FLEET_H
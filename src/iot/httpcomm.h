@@ -0,0 +1,671 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef HTTPCOMM_H
+#define HTTPCOMM_H
+
+#include "interfacecomm.h"
+#include "socket.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace iolink::iot
+{
+    struct HttpTimeouts
+    {
+        milliseconds_t connect{2000};  // Establishing a new TCP connection
+        milliseconds_t request{5000};  // Whole request: waiting for a free connection, sending and receiving
+    };
+
+    /*
+     * HTTP/1.1 implementation of InterfaceComm over POSIX sockets.
+     *
+     * Connections to the master are kept alive and pooled, so consecutive requests do not pay for the TCP handshake.
+     * Every connection owns its request and receive buffers, which keep their capacity between requests. A pooled
+     * connection that was closed by the master is detected on reuse and the request is retried once on a new
+     * connection. Only the requests that do not change the state of the master are retried, see isIdempotent(). A
+     * write may have reached the master before the connection was closed, so it fails instead of being sent twice.
+     *
+     * The asynchronous requests are multiplexed with poll() on a single I/O thread, which is started on the first
+     * asynchronous request. Up to max_connections requests are in flight at the same time, the rest are queued.
+     * Blocking and asynchronous requests share the same connection pool. The callbacks are invoked on the I/O thread.
+     * Whatever they throw is passed to iolink::utils::reportUnhandledException() and the loop continues.
+     */
+    class HttpComm: public InterfaceComm
+    {
+        public:
+            using Timeouts = HttpTimeouts;
+
+            explicit HttpComm(const string_t &ip, uint16_t port = 80, const Timeouts &timeouts = Timeouts{}, size_t max_connections = 4):
+                InterfaceComm{ip, port, Protocol::PROTO_HTTP, string_t{}, string_t{}},
+                m_host{ip + ":" + std::to_string(port)},
+                m_max_connections{max_connections},
+                m_timeouts{timeouts}
+            {
+                if(max_connections == 0)
+                    throw iolink::utils::exception_argument(__func__, "At least one connection must be allowed");
+            }
+
+            ~HttpComm() override
+            {
+                stopLoop();
+            }
+
+            string_t httpGet(const string_t &adr) const override
+            {
+                if(adr.empty())
+                    throw iolink::utils::exception_argument(__func__, "Address argument must be non empty string");
+
+                return request("GET", adr, std::string_view{});
+            }
+
+            string_t httpPost(const string_t &json) const override
+            {
+                if(json.empty())
+                    throw iolink::utils::exception_argument(__func__, "Request body must be non empty string");
+
+                return request("POST", "/", json);
+            }
+
+            void httpGetAsync(const string_t &adr, callback_t<string_t> callback) const override
+            {
+                if(adr.empty())
+                    return callback(string_t{}, std::make_exception_ptr(iolink::utils::exception_argument(__func__, "Address argument must be non empty string")));
+
+                submit("GET", adr, std::string_view{}, std::move(callback));
+            }
+
+            void httpPostAsync(const string_t &json, callback_t<string_t> callback) const override
+            {
+                if(json.empty())
+                    return callback(string_t{}, std::make_exception_ptr(iolink::utils::exception_argument(__func__, "Request body must be non empty string")));
+
+                submit("POST", "/", json, std::move(callback));
+            }
+
+            Timeouts timeouts() const
+            {
+                std::lock_guard lock{m_mutex};
+                return m_timeouts;
+            }
+
+            void setTimeouts(const Timeouts &timeouts)
+            {
+                std::lock_guard lock{m_mutex};
+                m_timeouts = timeouts;
+            }
+
+            size_t maxConnections() const
+            {
+                return m_max_connections;
+            }
+
+            size_t idleConnections() const
+            {
+                std::lock_guard lock{m_mutex};
+                return m_idle.size();
+            }
+
+            void closeIdleConnections() const
+            {
+                std::vector<std::unique_ptr<Connection>> idle;
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_open -= m_idle.size();
+                    idle.swap(m_idle);
+                }
+
+                m_cv.notify_all();
+            }
+
+        protected:
+            struct Connection
+            {
+                Socket     socket;
+                HttpParser parser;
+                string_t   request;
+                bool       reused = false;
+            };
+
+            string_t request(std::string_view method, std::string_view target, std::string_view body) const
+            {
+                const auto timeouts = this->timeouts();
+                const auto deadline = steady_clock_t::now() + timeouts.request;
+
+                for(bool retry = isIdempotent(method, body);; retry = false)
+                {
+                    auto connection = acquire(deadline, timeouts.connect);
+
+                    try
+                    {
+                        serialize(connection->request, method, target, body);
+                        connection->socket.sendAll(connection->request, deadline);
+
+                        auto &message = receive(*connection, deadline);
+                        auto response = std::move(message.body);
+                        auto status   = message.status;
+
+                        if(message.keep_alive)
+                        {
+                            connection->parser.next();
+                            release(std::move(connection));
+                        }
+                        else
+                            drop(std::move(connection));
+
+                        if(response.empty() && (status < 200 || status >= 300))
+                            throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::BAD_RESPONSE, "HTTP status " + std::to_string(status));
+
+                        return response;
+                    }
+                    catch(const iolink::utils::exception_comm &e)
+                    {
+                        // The master may close an idle connection at any time. Retry reads once on a fresh one
+                        bool stale = connection && connection->reused && connection->parser.empty() &&
+                                     e.error_code() == iolink::utils::exception_comm::ErrorCodeType::ERROR_CONNECTION_CLOSED;
+
+                        if(connection)
+                            drop(std::move(connection));
+
+                        if(!(retry && stale))
+                            throw;
+                    }
+                    catch(...)
+                    {
+                        // A connection in an unknown state must not keep its slot of the pool
+                        if(connection)
+                            drop(std::move(connection));
+
+                        throw;
+                    }
+                }
+            }
+
+            /*
+             * A GET only reads. The POST requests carry the service in the address, which is always the first key of
+             * the body. The "get" services and the acyclic read do not change the master and can be sent again
+             */
+            static bool isIdempotent(std::string_view method, std::string_view body)
+            {
+                if(method == "GET")
+                    return true;
+
+                constexpr std::string_view head = R"({"adr":")";
+                if(body.substr(0, head.size()) != head)
+                    return false;
+
+                auto adr = body.substr(head.size());
+                adr = adr.substr(0, adr.find('"'));
+
+                auto service = adr.substr(adr.rfind('/') + 1);
+                return service.substr(0, 3) == "get" || service == "iolreadacyclic";
+            }
+
+            void serialize(string_t &buffer, std::string_view method, std::string_view target, std::string_view body) const
+            {
+                buffer.clear();
+                buffer.append(method).append(" ").append(target).append(" HTTP/1.1\r\nHost: ").append(m_host).append("\r\nConnection: keep-alive\r\n");
+
+                if(!body.empty())
+                    buffer.append("Content-Type: application/json\r\nContent-Length: ").append(std::to_string(body.size())).append("\r\n");
+
+                buffer.append("\r\n").append(body);
+            }
+
+            static HttpParser::Message& receive(Connection &connection, steady_clock_t::time_point deadline)
+            {
+                constexpr size_t chunk = 4096;
+
+                for(;;)
+                {
+                    auto received = connection.socket.receive(connection.parser.prepare(chunk), chunk);
+
+                    if(received > 0)
+                    {
+                        if(connection.parser.commit(static_cast<size_t>(received)))
+                            return connection.parser.message();
+
+                        continue;
+                    }
+
+                    connection.parser.commit(0);
+
+                    if(received < 0)
+                    {
+                        if(connection.parser.finish())
+                            return connection.parser.message();
+
+                        throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_CONNECTION_CLOSED);
+                    }
+
+                    if(!connection.socket.wait(POLLIN, Socket::remaining(deadline)))
+                        throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_TIMEOUT);
+                }
+            }
+
+            std::unique_ptr<Connection> acquire(steady_clock_t::time_point deadline, milliseconds_t connect_timeout) const
+            {
+                {
+                    std::unique_lock lock{m_mutex};
+
+                    if(!m_cv.wait_until(lock, deadline, [this]{return !m_idle.empty() || m_open < m_max_connections;}))
+                        throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_TIMEOUT, "No free connection");
+
+                    if(!m_idle.empty())
+                    {
+                        auto connection = std::move(m_idle.back());
+                        m_idle.pop_back();
+                        connection->reused = true;
+                        return connection;
+                    }
+
+                    ++m_open;
+                }
+
+                try
+                {
+                    auto connection = std::make_unique<Connection>();
+                    connection->socket = Socket::connect(m_ip, m_port, std::min(connect_timeout, Socket::remaining(deadline)));
+                    return connection;
+                }
+                catch(...)
+                {
+                    drop(nullptr);
+                    throw;
+                }
+            }
+
+            void release(std::unique_ptr<Connection> connection) const
+            {
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_idle.push_back(std::move(connection));
+                }
+
+                m_cv.notify_one();
+                wake();
+            }
+
+            void drop(std::unique_ptr<Connection> connection) const
+            {
+                connection.reset();
+
+                {
+                    std::lock_guard lock{m_mutex};
+                    --m_open;
+                }
+
+                m_cv.notify_one();
+                wake();
+            }
+
+            struct Transfer
+            {
+                string_t                    request;
+                callback_t<string_t>        callback;
+                steady_clock_t::time_point  deadline;
+                steady_clock_t::time_point  connect_deadline;
+                std::unique_ptr<Connection> connection;
+                size_t                      sent       = 0;
+                bool                        connecting = false;
+                bool                        retry      = false;
+            };
+
+            void submit(std::string_view method, std::string_view target, std::string_view body, callback_t<string_t> callback) const
+            {
+                Transfer transfer;
+                serialize(transfer.request, method, target, body);
+                transfer.callback = std::move(callback);
+                transfer.deadline = steady_clock_t::now() + timeouts().request;
+                transfer.retry    = isIdempotent(method, body);
+
+                {
+                    std::lock_guard lock{m_loop_mutex};
+
+                    if(m_stop)
+                        return iolink::utils::invokeGuarded(transfer.callback, string_t{}, std::make_exception_ptr(iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_IO, "Communication object is being destroyed")));
+
+                    startLoop();
+                    m_queue.push_back(std::move(transfer));
+                }
+
+                wake();
+            }
+
+            void startLoop() const
+            {
+                if(m_thread.joinable())
+                    return;
+
+                if(::pipe(m_wake) != 0)
+                    throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_IO, std::strerror(errno));
+
+                for(auto fd: m_wake)
+                    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+                m_thread = std::thread{[this]{loop();}};
+            }
+
+            void stopLoop() const
+            {
+                {
+                    std::lock_guard lock{m_loop_mutex};
+                    m_stop = true;
+                }
+
+                if(m_thread.joinable())
+                {
+                    wake();
+                    m_thread.join();
+                }
+
+                std::lock_guard lock{m_loop_mutex};
+                for(auto &fd: m_wake)
+                    if(fd >= 0)
+                        ::close(std::exchange(fd, -1));
+            }
+
+            void wake() const
+            {
+                std::lock_guard lock{m_loop_mutex};
+
+                if(m_wake[1] >= 0)
+                {
+                    char byte = 0;
+                    [[maybe_unused]] auto result = ::write(m_wake[1], &byte, 1);
+                }
+            }
+
+            void loop() const
+            {
+                using ErrorCodeType = iolink::utils::exception_comm::ErrorCodeType;
+
+                std::deque<Transfer>  waiting;
+                std::vector<Transfer> active;
+                std::vector<pollfd>   fds;
+                std::vector<std::pair<Transfer, std::exception_ptr>> finished;  // Completions are delivered outside of the loop bookkeeping
+
+                auto fail = [&finished](Transfer &&transfer, std::exception_ptr error)
+                {
+                    transfer.request.clear();
+                    finished.emplace_back(std::move(transfer), error);
+                };
+
+                for(;;)
+                {
+                    {
+                        std::lock_guard lock{m_loop_mutex};
+
+                        if(m_stop)
+                        {
+                            std::move(m_queue.begin(), m_queue.end(), std::back_inserter(waiting));
+                            m_queue.clear();
+                            break;
+                        }
+
+                        std::move(m_queue.begin(), m_queue.end(), std::back_inserter(waiting));
+                        m_queue.clear();
+                    }
+
+                    // Assign connections to the waiting requests
+                    while(!waiting.empty())
+                    {
+                        auto &transfer = waiting.front();
+
+                        try
+                        {
+                            if(!tryAcquire(transfer))
+                                break;
+
+                            active.push_back(std::move(transfer));
+                        }
+                        catch(...)
+                        {
+                            fail(std::move(transfer), std::current_exception());
+                        }
+
+                        waiting.pop_front();
+                    }
+
+                    fds.clear();
+                    fds.push_back({m_wake[0], POLLIN, 0});
+                    for(const auto &transfer: active)
+                        fds.push_back({transfer.connection->socket.fd(), short((transfer.connecting || transfer.sent < transfer.request.size()) ? POLLOUT : POLLIN), 0});
+
+                    auto now = steady_clock_t::now();
+                    auto next_deadline = steady_clock_t::time_point::max();
+                    for(const auto &transfer: active)
+                        next_deadline = std::min(next_deadline, transfer.connecting ? std::min(transfer.deadline, transfer.connect_deadline) : transfer.deadline);
+                    for(const auto &transfer: waiting)
+                        next_deadline = std::min(next_deadline, transfer.deadline);
+
+                    int timeout = (next_deadline == steady_clock_t::time_point::max()) ? -1 : static_cast<int>(Socket::remaining(next_deadline).count() + 1);
+
+                    // An error is handled as a timeout. The deadlines are checked below anyway
+                    if(::poll(fds.data(), fds.size(), timeout) < 0)
+                        for(auto &fd: fds)
+                            fd.revents = 0;
+
+                    if(fds[0].revents)
+                    {
+                        char buffer[64];
+                        while(::read(m_wake[0], buffer, sizeof(buffer)) > 0);
+                    }
+
+                    now = steady_clock_t::now();
+                    std::vector<Transfer> still_active;
+                    still_active.reserve(active.size());
+
+                    for(size_t i = 0; i < active.size(); ++i)
+                    {
+                        auto &transfer = active[i];
+
+                        try
+                        {
+                            if(fds[i + 1].revents && progress(transfer))
+                            {
+                                complete(std::move(transfer), finished);
+                                continue;
+                            }
+
+                            if(now >= transfer.deadline || (transfer.connecting && now >= transfer.connect_deadline))
+                                throw iolink::utils::exception_comm(__func__, ErrorCodeType::ERROR_TIMEOUT);
+
+                            still_active.push_back(std::move(transfer));
+                        }
+                        catch(const iolink::utils::exception_comm &e)
+                        {
+                            // The master may close an idle connection at any time. Retry reads once on a fresh one
+                            bool stale = transfer.retry && transfer.connection->reused && transfer.connection->parser.empty() &&
+                                         e.error_code() == ErrorCodeType::ERROR_CONNECTION_CLOSED;
+
+                            drop(std::move(transfer.connection));
+
+                            if(stale)
+                            {
+                                transfer.retry = false;
+                                transfer.sent  = 0;
+                                waiting.push_front(std::move(transfer));
+                            }
+                            else
+                                fail(std::move(transfer), std::current_exception());
+                        }
+                        catch(...)
+                        {
+                            drop(std::move(transfer.connection));
+                            fail(std::move(transfer), std::current_exception());
+                        }
+                    }
+
+                    active.swap(still_active);
+
+                    while(!waiting.empty() && now >= waiting.front().deadline)
+                    {
+                        fail(std::move(waiting.front()), std::make_exception_ptr(iolink::utils::exception_comm(__func__, ErrorCodeType::ERROR_TIMEOUT, "No free connection")));
+                        waiting.pop_front();
+                    }
+
+                    for(auto &[transfer, error]: finished)
+                        iolink::utils::invokeGuarded(transfer.callback, std::move(transfer.request), error);
+
+                    finished.clear();
+                }
+
+                auto error = std::make_exception_ptr(iolink::utils::exception_comm(__func__, ErrorCodeType::ERROR_IO, "Communication object is being destroyed"));
+
+                for(auto &transfer: active)
+                {
+                    drop(std::move(transfer.connection));
+                    iolink::utils::invokeGuarded(transfer.callback, string_t{}, error);
+                }
+
+                for(auto &transfer: waiting)
+                    iolink::utils::invokeGuarded(transfer.callback, string_t{}, error);
+            }
+
+            bool tryAcquire(Transfer &transfer) const
+            {
+                {
+                    std::lock_guard lock{m_mutex};
+
+                    if(!m_idle.empty())
+                    {
+                        transfer.connection = std::move(m_idle.back());
+                        transfer.connection->reused = true;
+                        transfer.connecting = false;
+                        m_idle.pop_back();
+                        return true;
+                    }
+
+                    if(m_open >= m_max_connections)
+                        return false;
+
+                    ++m_open;
+                }
+
+                try
+                {
+                    transfer.connection = std::make_unique<Connection>();
+                    transfer.connection->socket = Socket::connectAsync(m_ip, m_port);
+                    transfer.connecting = true;
+                    transfer.connect_deadline = steady_clock_t::now() + timeouts().connect;
+                    return true;
+                }
+                catch(...)
+                {
+                    drop(std::move(transfer.connection));
+                    throw;
+                }
+            }
+
+            // Returns true when the response is complete
+            static bool progress(Transfer &transfer)
+            {
+                constexpr size_t chunk = 4096;
+                auto &connection = *transfer.connection;
+
+                if(transfer.connecting)
+                {
+                    if(auto error = connection.socket.pendingError(); error != 0)
+                        throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_CONNECT, std::strerror(error));
+
+                    transfer.connecting = false;
+                }
+
+                while(transfer.sent < transfer.request.size())
+                {
+                    auto sent = connection.socket.send(transfer.request.data() + transfer.sent, transfer.request.size() - transfer.sent);
+                    if(!sent)
+                        return false;
+
+                    transfer.sent += sent;
+                }
+
+                for(;;)
+                {
+                    auto received = connection.socket.receive(connection.parser.prepare(chunk), chunk);
+
+                    if(received > 0)
+                    {
+                        if(connection.parser.commit(static_cast<size_t>(received)))
+                            return true;
+
+                        continue;
+                    }
+
+                    connection.parser.commit(0);
+
+                    if(received < 0)
+                    {
+                        if(connection.parser.finish())
+                            return true;
+
+                        throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_CONNECTION_CLOSED);
+                    }
+
+                    return false;
+                }
+            }
+
+            void complete(Transfer &&transfer, std::vector<std::pair<Transfer, std::exception_ptr>> &finished) const
+            {
+                auto &message = transfer.connection->parser.message();
+                auto status   = message.status;
+
+                // The response body is delivered in the request buffer
+                transfer.request = std::move(message.body);
+
+                if(message.keep_alive)
+                {
+                    transfer.connection->parser.next();
+                    release(std::move(transfer.connection));
+                }
+                else
+                    drop(std::move(transfer.connection));
+
+                std::exception_ptr error;
+                if(transfer.request.empty() && (status < 200 || status >= 300))
+                    error = std::make_exception_ptr(iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::BAD_RESPONSE, "HTTP status " + std::to_string(status)));
+
+                finished.emplace_back(std::move(transfer), error);
+            }
+
+        protected:
+            const string_t m_host;
+            const size_t   m_max_connections;
+
+            Timeouts                                         m_timeouts;
+            mutable std::mutex                               m_mutex;
+            mutable std::condition_variable                  m_cv;
+            mutable std::vector<std::unique_ptr<Connection>> m_idle;
+            mutable size_t                                   m_open = 0;  // Idle and busy connections
+
+            mutable std::mutex           m_loop_mutex;
+            mutable std::deque<Transfer> m_queue;
+            mutable std::thread          m_thread;
+            mutable int                  m_wake[2] = {-1, -1};  // Self pipe used to interrupt poll()
+            mutable bool                 m_stop    = false;
+    };
+}
+
+#endif // HTTPCOMM_H
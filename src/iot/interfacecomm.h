@@ -43,6 +43,43 @@ namespace iolink::iot
             virtual string_t httpGet(const string_t &url) const =0;
             virtual string_t httpPost(const string_t &json_t) const =0;
 
+            /*
+             * Asynchronous variants of httpGet() and httpPost(). The callback may be invoked from any thread, so it
+             * must not block. The default implementation executes the blocking call and invokes the callback before
+             * returning. Override them to keep many requests in flight at the same time.
+             */
+            virtual void httpGetAsync(const string_t &url, callback_t<string_t> callback) const
+            {
+                string_t response;
+
+                try
+                {
+                    response = httpGet(url);
+                }
+                catch(...)
+                {
+                    return callback(string_t{}, std::current_exception());
+                }
+
+                callback(std::move(response), nullptr);
+            }
+
+            virtual void httpPostAsync(const string_t &json, callback_t<string_t> callback) const
+            {
+                string_t response;
+
+                try
+                {
+                    response = httpPost(json);
+                }
+                catch(...)
+                {
+                    return callback(string_t{}, std::current_exception());
+                }
+
+                callback(std::move(response), nullptr);
+            }
+
             void applySecurityToRequestObject(json_t &request)
             {
                 if(!m_username.empty())
@@ -54,13 +91,20 @@ namespace iolink::iot
                 return !m_username.empty();
             }
 
+            // Serialized "auth" object of the requests. Empty if the security mode is off
+            const string_t& authJson() const
+            {
+                return m_auth;
+            }
+
         protected:
             InterfaceComm(const string_t &ip, const uint16_t port, const Protocol proto, const string_t username, const string_t password):
                 m_ip{ip},
                 m_port{port},
                 m_username{username},
                 m_password{password},
-                m_proto{(!username.empty()?Protocol::PROTO_HTTPS:proto)}
+                m_proto{(!username.empty()?Protocol::PROTO_HTTPS:proto)},
+                m_auth{username.empty()?string_t{}:json_t{{"user", utils::base64Encode(username)}, {"passwd", utils::base64Encode(password)}}.dump()}
             {
                 if(port == 0)
                     throw iolink::utils::exception_argument(__func__, "Port must be in the range 1:65535");
@@ -84,6 +128,7 @@ namespace iolink::iot
             const string_t m_username;
             const string_t m_password;
             const Protocol m_proto;
+            const string_t m_auth;
     };
 }
 
@@ -0,0 +1,437 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef POLLER_H
+#define POLLER_H
+
+#include "executor.h"
+#include "structdevice.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace iolink::iot
+{
+    // Value of an element read by a Poller
+    template<typename T>
+    struct Sample
+    {
+        T                                      value{};
+        std::chrono::system_clock::time_point  timestamp;  // Time when the response was received
+    };
+
+    /*
+     * Reads elements of a master periodically. The elements that are due at the same time are read together with a
+     * single /getdatamulti request and every handler receives a timestamped sample. The schedule is absolute, so the
+     * time spent on the requests and the handlers does not accumulate as drift. A cycle that can not keep up is
+     * skipped instead of being executed late in a burst.
+     *
+     * Example:
+     *
+     *     iolink::iot::Poller poller{al1352};
+     *     poller.add(al1352.iolinkmaster.port1.iolinkdevice.pdin, std::chrono::milliseconds{5}, [](iolink::iot::Sample<std::string> sample, std::exception_ptr error){});
+     *     poller.add(al1352.processdatamaster.voltage, std::chrono::seconds{1}, [](iolink::iot::Sample<int64_t> sample, std::exception_ptr error){});
+     *     poller.addTask(std::chrono::seconds{60}, [&](iolink::callback_t<void> done)
+     *     {
+     *         o1d105_drv->operating_hours.readAsync([done](int32_t hours, std::exception_ptr error){done(error);});
+     *     });
+     *     poller.start();
+     *
+     * The handlers are executed by the thread of the poller, or by the thread that calls poll(), so they should return
+     * quickly. The tasks are only started there and must not block, use the asynchronous API or an executor for them.
+     * Whatever the handlers and the tasks throw or report is passed to the error handler and the schedule continues.
+     */
+    class Poller
+    {
+        public:
+            using steady_clock_t = std::chrono::steady_clock;
+            using duration_t     = steady_clock_t::duration;
+            using id_t           = size_t;
+
+            // Receives the exceptions thrown by the handlers and the tasks together with the id of their entry
+            using error_handler_t = std::function<void(id_t, std::exception_ptr)>;
+
+            // Elements that are due within the window are read together with the due ones
+            explicit Poller(const StructDevice &device, bool consistent = false, duration_t window = std::chrono::milliseconds{1}):
+                m_device{device},
+                m_consistent{consistent},
+                m_window{window}
+            {}
+
+            Poller(const Poller&) =delete;
+            Poller& operator= (const Poller&) =delete;
+
+            // Waits for the tasks in flight, because their completions refer to the poller
+            ~Poller()
+            {
+                stop();
+
+                std::unique_lock lock{m_mutex};
+                m_cv.wait(lock, [this]{return m_in_flight == 0;});
+            }
+
+            template<typename Element>
+            id_t add(const Element &element, duration_t period, callback_t<Sample<typename Element::type_t>> handler)
+            {
+                using T = typename Element::type_t;
+
+                return add(period, element.address(), [handler = std::move(handler)](const json_t *response, std::chrono::system_clock::time_point timestamp, std::exception_ptr error)
+                {
+                    Sample<T> sample;
+                    sample.timestamp = timestamp;
+
+                    if(!error)
+                    {
+                        try
+                        {
+                            sample.value = BaseElement::checkResponseCode(*response)["data"].template get<T>();
+                        }
+                        catch(...)
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+
+                    handler(std::move(sample), error);
+                });
+            }
+
+            /*
+             * Starts the task periodically, for example an asynchronous read of a device parameter. The task receives
+             * the completion of the run and must call it exactly once. A cycle is skipped while the previous run is in
+             * flight. The exceptions thrown by the task or passed to the completion go to the error handler.
+             */
+            id_t addTask(duration_t period, std::function<void(callback_t<void>)> task)
+            {
+                auto entry = std::make_shared<Task>();
+                entry->start = std::move(task);
+
+                return add(period, string_t{}, nullptr, std::move(entry));
+            }
+
+            // Executes a blocking task periodically on the executor, so it does not delay the schedule
+            id_t addTask(duration_t period, InterfaceExecutor &executor, std::function<void()> task)
+            {
+                return addTask(period, [&executor, task = std::make_shared<std::function<void()>>(std::move(task))](callback_t<void> done)
+                {
+                    executor.post([task, done = std::move(done)]
+                    {
+                        std::exception_ptr error;
+
+                        try
+                        {
+                            (*task)();
+                        }
+                        catch(...)
+                        {
+                            error = std::current_exception();
+                        }
+
+                        done(error);
+                    });
+                });
+            }
+
+            void remove(id_t id)
+            {
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_entries.erase(id);
+                }
+
+                m_cv.notify_all();
+            }
+
+            size_t size() const
+            {
+                std::lock_guard lock{m_mutex};
+                return m_entries.size();
+            }
+
+            // Without an error handler the exceptions are passed to iolink::utils::reportUnhandledException()
+            void setErrorHandler(error_handler_t handler)
+            {
+                std::lock_guard lock{m_mutex};
+                m_error_handler = std::move(handler);
+            }
+
+            /*
+             * Executes everything that is due. Returns the time when the next entry is due, or time_point::max() if
+             * there are no entries.
+             */
+            steady_clock_t::time_point poll()
+            {
+                std::vector<std::pair<id_t, std::shared_ptr<handler_t>>> elements;
+                std::vector<string_t>                                    urls;
+                std::vector<std::pair<id_t, std::shared_ptr<Task>>>      tasks;
+
+                {
+                    std::lock_guard lock{m_mutex};
+
+                    const auto now = steady_clock_t::now();
+
+                    for(auto &[id, entry]: m_entries)
+                    {
+                        if(entry.next > now + m_window)
+                            continue;
+
+                        if(entry.url.empty())
+                            tasks.emplace_back(id, entry.task);
+                        else
+                        {
+                            elements.emplace_back(id, entry.handler);
+                            urls.push_back(entry.url);
+                        }
+
+                        // Keep the phase of the schedule and skip the cycles that were missed
+                        entry.next += entry.period;
+                        if(entry.next <= now)
+                            entry.next += ((now - entry.next) / entry.period + 1) * entry.period;
+                    }
+                }
+
+                if(!elements.empty())
+                    dispatch(elements, urls);
+
+                for(const auto &[id, task]: tasks)
+                    startTask(id, task);
+
+                return nextDue();
+            }
+
+            // Starts a thread that executes the entries on time
+            void start()
+            {
+                std::lock_guard lock{m_mutex};
+
+                if(m_thread.joinable())
+                    return;
+
+                m_stop   = false;
+                m_thread = std::thread([this]
+                {
+                    for(;;)
+                    {
+                        const auto next = poll();
+
+                        std::unique_lock lock{m_mutex};
+
+                        if(m_cv.wait_until(lock, next, [this]{return m_stop || m_changed;}) && m_stop)
+                            return;
+
+                        m_changed = false;
+                    }
+                });
+            }
+
+            void stop()
+            {
+                {
+                    std::lock_guard lock{m_mutex};
+                    m_stop = true;
+                }
+
+                m_cv.notify_all();
+
+                if(m_thread.joinable() && m_thread.get_id() != std::this_thread::get_id())
+                    m_thread.join();
+            }
+
+        private:
+            using handler_t = std::function<void(const json_t*, std::chrono::system_clock::time_point, std::exception_ptr)>;
+
+            struct Task
+            {
+                std::function<void(callback_t<void>)>  start;
+                std::atomic<bool>                      running{false};
+            };
+
+            struct Entry
+            {
+                string_t                    url;      // Empty for a task
+                duration_t                  period;
+                steady_clock_t::time_point  next;
+                std::shared_ptr<handler_t>  handler;  // Of an element
+                std::shared_ptr<Task>       task;
+            };
+
+            id_t add(duration_t period, string_t url, handler_t handler, std::shared_ptr<Task> task = nullptr)
+            {
+                if(period <= duration_t::zero())
+                    throw iolink::utils::exception_argument(__func__, "Period must be positive");
+
+                id_t id;
+
+                {
+                    std::lock_guard lock{m_mutex};
+
+                    id = ++m_last_id;
+                    m_entries.emplace(id, Entry{std::move(url), period, steady_clock_t::now(), std::make_shared<handler_t>(std::move(handler)), std::move(task)});
+                    m_changed = true;
+                }
+
+                m_cv.notify_all();
+
+                return id;
+            }
+
+            void dispatch(const std::vector<std::pair<id_t, std::shared_ptr<handler_t>>> &handlers, std::vector<string_t> urls) const
+            {
+                json_t             response;
+                std::exception_ptr error;
+
+                try
+                {
+                    // The same element may be registered more than once
+                    std::vector<string_t> unique_urls = urls;
+                    std::sort(unique_urls.begin(), unique_urls.end());
+                    unique_urls.erase(std::unique(unique_urls.begin(), unique_urls.end()), unique_urls.end());
+
+                    response = m_device.getDataMulti(std::move(unique_urls), m_consistent);
+                }
+                catch(...)
+                {
+                    error = std::current_exception();
+                }
+
+                const auto timestamp = std::chrono::system_clock::now();
+                static const json_t missing{{"code", -1}};
+
+                for(size_t i = 0; i < handlers.size(); ++i)
+                {
+                    const auto &[id, handler] = handlers[i];
+
+                    if(error)
+                    {
+                        invoke(id, *handler, nullptr, timestamp, error);
+                        continue;
+                    }
+
+                    // Every element gets its own response code, so one failed element does not fail the others
+                    const json_t *value = &missing;
+
+                    if(auto data = response.find("data"); data != response.end())
+                        if(auto it = data->find(urls[i]); it != data->end())
+                            value = &*it;
+
+                    invoke(id, *handler, value, timestamp, nullptr);
+                }
+            }
+
+            // A throwing handler must not stop the schedule
+            void invoke(id_t id, const handler_t &handler, const json_t *response, std::chrono::system_clock::time_point timestamp, std::exception_ptr error) const
+            {
+                try
+                {
+                    handler(response, timestamp, error);
+                }
+                catch(...)
+                {
+                    reportError(id, std::current_exception());
+                }
+            }
+
+            // Only starts the task, its completion may come from any thread
+            void startTask(id_t id, const std::shared_ptr<Task> &task)
+            {
+                if(task->running.exchange(true))
+                    return;
+
+                {
+                    std::lock_guard lock{m_mutex};
+                    ++m_in_flight;
+                }
+
+                // The first outcome counts, whether it is the completion or an exception of the start
+                auto completed = std::make_shared<std::atomic<bool>>(false);
+
+                auto finish = [this, id, task, completed](std::exception_ptr error)
+                {
+                    if(completed->exchange(true))
+                        return;
+
+                    if(error)
+                        reportError(id, error);
+
+                    task->running = false;
+
+                    // Notified under the lock, because the destructor may return as soon as the count drops
+                    std::lock_guard lock{m_mutex};
+                    --m_in_flight;
+                    m_cv.notify_all();
+                };
+
+                try
+                {
+                    task->start(finish);
+                }
+                catch(...)
+                {
+                    finish(std::current_exception());
+                }
+            }
+
+            void reportError(id_t id, std::exception_ptr error) const
+            {
+                error_handler_t error_handler;
+
+                {
+                    std::lock_guard lock{m_mutex};
+                    error_handler = m_error_handler;
+                }
+
+                if(error_handler)
+                    iolink::utils::invokeGuarded(error_handler, id, error);
+                else
+                    iolink::utils::reportUnhandledException(error);
+            }
+
+            steady_clock_t::time_point nextDue() const
+            {
+                std::lock_guard lock{m_mutex};
+
+                auto next = steady_clock_t::time_point::max();
+
+                for(const auto &[id, entry]: m_entries)
+                    next = std::min(next, entry.next);
+
+                return next;
+            }
+
+        private:
+            const StructDevice&      m_device;
+            const bool               m_consistent;
+            const duration_t         m_window;
+            mutable std::mutex       m_mutex;
+            std::condition_variable  m_cv;
+            std::map<id_t, Entry>    m_entries;
+            error_handler_t          m_error_handler;
+            id_t                     m_last_id   = 0;
+            size_t                   m_in_flight = 0;
+            bool                     m_changed   = false;
+            bool                     m_stop      = false;
+            std::thread              m_thread;
+    };
+}
+
+#endif // POLLER_H
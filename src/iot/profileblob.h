@@ -37,9 +37,12 @@ namespace iolink::iot
             }
 
             json_t setBlobData() const{ return json_t{};} // FIXME: to complete function body
-            json_t getBlobData(uint32_t pos, uint32_t len) const{return requestPost("/getblobdata",R"("pos":)"+std::to_string(pos)+R"(,"length":)"+std::to_string(len));}
+            json_t getBlobData(uint32_t pos, uint32_t len) const{return requestPost(m_get_blob_data, blobRange(pos, len));}
+            void getBlobDataAsync(uint32_t pos, uint32_t len, callback_t<json_t> callback) const{requestPostAsync(m_get_blob_data, blobRange(pos, len), std::move(callback));}
             json_t startStreamSet(uint64_t size) const{return requestPost("/start_stream_set",R"("size":)"+std::to_string(size));}
-            json_t streamSet(const string_t &data) const{{return requestPost("/stream_set",R"("value":)"+data);}}
+            // The data must be base64 encoded
+            json_t streamSet(const string_t &data) const{return requestPost(m_stream_set, streamSetData(data));}
+            void streamSetAsync(const string_t &data, callback_t<json_t> callback) const{requestPostAsync(m_stream_set, streamSetData(data), std::move(callback));}
             json_t clear() const{return requestGet("/clear");}
             json_t getCRC() const{return requestGet("/getcrc");}
             json_t getMD5() const{return requestGet("/getmd5");}
@@ -48,6 +51,27 @@ namespace iolink::iot
 
             AccessRead<DataTypeInt> size{"size", this};
             AccessRead<DataTypeInt> chunksize{"chunksize", this};
+
+        private:
+            // Base64 does not need to be escaped in JSON
+            static string_t streamSetData(const string_t &data)
+            {
+                string_t json;
+                json.reserve(data.size() + 12);
+                json += R"({"value":")";
+                json += data;
+                json += R"("})";
+
+                return json;
+            }
+
+            static string_t blobRange(uint32_t pos, uint32_t len)
+            {
+                return R"({"pos":)"+std::to_string(pos)+R"(,"length":)"+std::to_string(len)+"}";
+            }
+
+            const RequestTemplate m_stream_set{requestTemplate("/stream_set")};
+            const RequestTemplate m_get_blob_data{requestTemplate("/getblobdata")};
     };
 }
 
@@ -37,7 +37,9 @@ namespace iolink::iot
         public:
             explicit ProfileIOLinkDevice(BaseElement *parent):
                 BaseElement{"iolinkdevice", parent},
-                m_self_ptr{this, [](void *){}} // Pass null deleter, because this object is managed by the caller(can be allocated on the heap or be static)
+                m_self_ptr{this, [](void *){}}, // Pass null deleter, because this object is managed by the caller(can be allocated on the heap or be static)
+                m_iolreadacyclic{requestTemplate("/iolreadacyclic")},
+                m_iolwriteacyclic{requestTemplate("/iolwriteacyclic")}
             {
                 if(!m_parent)
                     throw iolink::utils::exception_argument(__func__, "Parent for this element can not be empty");
@@ -45,12 +47,12 @@ namespace iolink::iot
 
             json_t iolReadAcyclic(uint32_t index, uint32_t sub_index = 0) const
             {
-                return requestPost("/iolreadacyclic", R"("index":)"+std::to_string(index)+R"(,"subindex":)"+std::to_string(sub_index));
+                return requestPost(m_iolreadacyclic, acyclicData(index, sub_index));
             }
 
             json_t iolWriteAcyclic(const string_t &value, uint32_t index, uint32_t sub_index) const
             {
-                return requestPost("/iolwriteacyclic", R"("index":)"+std::to_string(index)+R"(,"subindex":)"+std::to_string(sub_index)+R"(,"value":")"+value+R"(")");
+                return requestPost(m_iolwriteacyclic, acyclicData(index, sub_index, value));
             }
 
             template<typename T>
@@ -62,7 +64,77 @@ namespace iolink::iot
             template<typename T>
             T read(uint32_t index, uint32_t sub_index = 0) const
             {
-                return utils::hexDecode<T>(string_t{iolReadAcyclic(index, sub_index)["data"]["value"]});
+                return utils::hexDecode<T>(readHex(index, sub_index));
+            }
+
+            // Raw value of a parameter as a hex string
+            string_t readHex(uint32_t index, uint32_t sub_index = 0) const
+            {
+                return requestPostValue<string_t>(m_iolreadacyclic, acyclicData(index, sub_index));
+            }
+
+            void iolReadAcyclicAsync(uint32_t index, uint32_t sub_index, callback_t<json_t> callback) const
+            {
+                requestPostAsync(m_iolreadacyclic, acyclicData(index, sub_index), std::move(callback));
+            }
+
+            void iolWriteAcyclicAsync(const string_t &value, uint32_t index, uint32_t sub_index, callback_t<json_t> callback) const
+            {
+                requestPostAsync(m_iolwriteacyclic, acyclicData(index, sub_index, value), std::move(callback));
+            }
+
+            template<typename T>
+            void readAsync(uint32_t index, uint32_t sub_index, callback_t<T> callback) const
+            {
+                readHexAsync(index, sub_index, [callback = std::move(callback)](string_t hex, std::exception_ptr error)
+                {
+                    T value{};
+
+                    if(!error)
+                    {
+                        try
+                        {
+                            value = utils::hexDecode<T>(hex);
+                        }
+                        catch(...)
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+
+                    callback(std::move(value), error);
+                });
+            }
+
+            void readHexAsync(uint32_t index, uint32_t sub_index, callback_t<string_t> callback) const
+            {
+                iolReadAcyclicAsync(index, sub_index, [callback = std::move(callback)](json_t response, std::exception_ptr error)
+                {
+                    string_t value;
+
+                    if(!error)
+                    {
+                        try
+                        {
+                            value = response["data"]["value"].get<string_t>();
+                        }
+                        catch(...)
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+
+                    callback(std::move(value), error);
+                });
+            }
+
+            template<typename T>
+            void writeAsync(T value, uint32_t index, uint32_t sub_index, callback_t<void> callback) const
+            {
+                iolWriteAcyclicAsync(utils::hexEncode(std::forward<T>(value)), index, sub_index, [callback = std::move(callback)](json_t, std::exception_ptr error)
+                {
+                    callback(error);
+                });
             }
 
             template<typename T>
@@ -117,6 +189,18 @@ namespace iolink::iot
                     {3, "State communication error"}}};
             AccessReadWrite<DataTypeString, DataEvent> iolinkevent{"iolinkevent", this};
 
+        private:
+            // Serialized data objects of the acyclic services. The value is a hex string, so it needs no escaping
+            static string_t acyclicData(uint32_t index, uint32_t sub_index)
+            {
+                return R"({"index":)"+std::to_string(index)+R"(,"subindex":)"+std::to_string(sub_index)+"}";
+            }
+
+            static string_t acyclicData(uint32_t index, uint32_t sub_index, const string_t &value)
+            {
+                return R"({"index":)"+std::to_string(index)+R"(,"subindex":)"+std::to_string(sub_index)+R"(,"value":")"+value+R"("})";
+            }
+
         private:
             std::shared_ptr<iodd::BaseDriver> m_driver;
             /*
@@ -125,6 +209,9 @@ namespace iolink::iot
              * by the caller.
              */
             std::shared_ptr<ProfileIOLinkDevice> m_self_ptr;
+
+            const RequestTemplate m_iolreadacyclic;
+            const RequestTemplate m_iolwriteacyclic;
     };
 }
 
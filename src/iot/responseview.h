@@ -0,0 +1,300 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RESPONSEVIEW_H
+#define RESPONSEVIEW_H
+
+#include "../inc.h"
+
+#include <cctype>
+#include <charconv>
+#include <string_view>
+
+namespace iolink::iot
+{
+    /*
+     * Non owning view over a raw master response. It extracts "code", "error" and "data.value" by scanning the text
+     * once, without building a json_t DOM and without allocating. The rest of the response is skipped.
+     *
+     * Only the layout of the master responses is recognized. isValid() returns false for anything else, in which
+     * case the caller should fall back to json_t::parse().
+     */
+    class ResponseView
+    {
+        public:
+            explicit ResponseView(std::string_view response) noexcept:
+                m_response{response}
+            {
+                m_valid = scan();
+            }
+
+            bool isValid() const
+            {
+                return m_valid;
+            }
+
+            int code() const
+            {
+                return m_code;
+            }
+
+            // Raw content of the "error" string, still JSON escaped. Empty if missing
+            std::string_view error() const
+            {
+                return m_error;
+            }
+
+            // Raw JSON text of "data.value". Empty if missing
+            std::string_view value() const
+            {
+                return m_value;
+            }
+
+            /*
+             * Converts "data.value" to T. Strings without escape sequences and integers are converted directly, all
+             * the other values through json_t.
+             */
+            template<typename T>
+            T get() const
+            {
+                if constexpr(std::is_same_v<T, string_t>)
+                {
+                    if(m_value.size() >= 2 && m_value.front() == '"' && m_value.find('\\') == std::string_view::npos)
+                        return string_t{m_value.substr(1, m_value.size() - 2)};
+                }
+                else if constexpr(std::is_same_v<T, bool>)
+                {
+                    if(m_value == "true")  return true;
+                    if(m_value == "false") return false;
+                }
+                else if constexpr(std::is_integral_v<T>)
+                {
+                    T result{};
+                    auto [ptr, ec] = std::from_chars(m_value.data(), m_value.data() + m_value.size(), result);
+
+                    if(ec == std::errc{} && ptr == m_value.data() + m_value.size())
+                        return result;
+                }
+
+                return json_t::parse(m_value.begin(), m_value.end()).get<T>();
+            }
+
+            string_t errorString() const
+            {
+                if(m_error.find('\\') == std::string_view::npos)
+                    return string_t{m_error};
+
+                return json_t::parse("\""+string_t{m_error}+"\"").get<string_t>();
+            }
+
+        private:
+            bool scan()
+            {
+                skipWhitespace();
+                if(!consume('{'))
+                    return false;
+
+                bool has_code = false;
+
+                return parseMembers([this, &has_code](std::string_view key)
+                {
+                    if(key == "code")
+                    {
+                        auto [ptr, ec] = std::from_chars(m_response.data() + m_pos, m_response.data() + m_response.size(), m_code);
+                        if(ec != std::errc{})
+                            return false;
+
+                        m_pos = static_cast<size_t>(ptr - m_response.data());
+                        has_code = true;
+                        return true;
+                    }
+
+                    if(key == "error" && peek() == '"')
+                        return parseString(m_error);
+
+                    if(key == "data" && peek() == '{')
+                    {
+                        consume('{');
+
+                        return parseMembers([this](std::string_view data_key)
+                        {
+                            if(data_key == "value")
+                            {
+                                auto begin = m_pos;
+                                if(!skipValue())
+                                    return false;
+
+                                m_value = m_response.substr(begin, m_pos - begin);
+                                return true;
+                            }
+
+                            return skipValue();
+                        });
+                    }
+
+                    return skipValue();
+                }) && has_code;
+            }
+
+            // Parses the members of an object after the opening brace up to and including the closing brace
+            template<typename Handler>
+            bool parseMembers(Handler &&handler)
+            {
+                skipWhitespace();
+                if(consume('}'))
+                    return true;
+
+                for(;;)
+                {
+                    std::string_view key;
+
+                    skipWhitespace();
+                    if(!parseString(key))
+                        return false;
+
+                    skipWhitespace();
+                    if(!consume(':'))
+                        return false;
+
+                    skipWhitespace();
+                    if(!handler(key))
+                        return false;
+
+                    skipWhitespace();
+                    if(consume('}'))
+                        return true;
+
+                    if(!consume(','))
+                        return false;
+                }
+            }
+
+            // Returns the raw content between the quotes
+            bool parseString(std::string_view &str)
+            {
+                if(!consume('"'))
+                    return false;
+
+                auto begin = m_pos;
+
+                for(; m_pos < m_response.size(); ++m_pos)
+                {
+                    if(m_response[m_pos] == '\\')
+                        ++m_pos;
+                    else if(m_response[m_pos] == '"')
+                    {
+                        str = m_response.substr(begin, m_pos - begin);
+                        ++m_pos;
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            bool skipValue()
+            {
+                std::string_view str;
+
+                switch(peek())
+                {
+                    case '"':
+                        return parseString(str);
+
+                    case '{':
+                    case '[':
+                    {
+                        size_t depth = 0;
+
+                        while(m_pos < m_response.size())
+                        {
+                            switch(m_response[m_pos])
+                            {
+                                case '"':
+                                    if(!parseString(str))
+                                        return false;
+                                    continue;
+
+                                case '{':
+                                case '[':
+                                    ++depth;
+                                    break;
+
+                                case '}':
+                                case ']':
+                                    if(--depth == 0)
+                                    {
+                                        ++m_pos;
+                                        return true;
+                                    }
+                                    break;
+                            }
+
+                            ++m_pos;
+                        }
+
+                        return false;
+                    }
+
+                    default:
+                    {
+                        // Number, true, false or null
+                        auto begin = m_pos;
+
+                        while(m_pos < m_response.size() && m_response[m_pos] != ',' && m_response[m_pos] != '}' && m_response[m_pos] != ']' &&
+                              !std::isspace(static_cast<unsigned char>(m_response[m_pos])))
+                            ++m_pos;
+
+                        return m_pos != begin;
+                    }
+                }
+            }
+
+            void skipWhitespace()
+            {
+                while(m_pos < m_response.size() && std::isspace(static_cast<unsigned char>(m_response[m_pos])))
+                    ++m_pos;
+            }
+
+            char peek() const
+            {
+                return m_pos < m_response.size() ? m_response[m_pos] : '\0';
+            }
+
+            bool consume(char ch)
+            {
+                if(peek() != ch)
+                    return false;
+
+                ++m_pos;
+                return true;
+            }
+
+        private:
+            std::string_view m_response;
+            std::string_view m_error;
+            std::string_view m_value;
+            size_t           m_pos   = 0;
+            int              m_code  = 0;
+            bool             m_valid = false;
+    };
+}
+
+#endif // RESPONSEVIEW_H
@@ -0,0 +1,600 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SOCKET_H
+#define SOCKET_H
+
+#include "../inc.h"
+#include "../exception.h"
+
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace iolink::iot
+{
+    using milliseconds_t = std::chrono::milliseconds;
+    using steady_clock_t = std::chrono::steady_clock;
+
+    /*
+     * Thin RAII wrapper over a non blocking POSIX TCP socket. All blocking helpers are implemented with poll(), so
+     * every operation is bounded by a timeout.
+     */
+    class Socket
+    {
+        public:
+            Socket() =default;
+            Socket(const Socket&) =delete;
+            Socket& operator= (const Socket&) =delete;
+
+            Socket(Socket&& other) noexcept:
+                m_fd{std::exchange(other.m_fd, -1)}
+            {}
+
+            Socket& operator= (Socket&& other) noexcept
+            {
+                if(this != &other)
+                {
+                    close();
+                    m_fd = std::exchange(other.m_fd, -1);
+                }
+
+                return *this;
+            }
+
+            ~Socket()
+            {
+                close();
+            }
+
+            static Socket connect(const string_t &ip, uint16_t port, milliseconds_t timeout)
+            {
+                Socket socket{::socket(AF_INET, SOCK_STREAM, 0)};
+                if(!socket.isValid())
+                    throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_CONNECT, std::strerror(errno));
+
+                socket.setNonBlocking();
+
+                int flag = 1;
+                ::setsockopt(socket.m_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+                auto address = makeAddress(ip, port);
+                if(::connect(socket.m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+                {
+                    if(errno != EINPROGRESS)
+                        throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_CONNECT, std::strerror(errno));
+
+                    if(!socket.wait(POLLOUT, timeout))
+                        throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_TIMEOUT, ip + ":" + std::to_string(port));
+
+                    if(auto error = socket.pendingError(); error != 0)
+                        throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_CONNECT, std::strerror(error));
+                }
+
+                return socket;
+            }
+
+            // Start a non blocking connect. Completion is signaled by POLLOUT and must be checked with pendingError()
+            static Socket connectAsync(const string_t &ip, uint16_t port)
+            {
+                Socket socket{::socket(AF_INET, SOCK_STREAM, 0)};
+                if(!socket.isValid())
+                    throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_CONNECT, std::strerror(errno));
+
+                socket.setNonBlocking();
+
+                int flag = 1;
+                ::setsockopt(socket.m_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+                auto address = makeAddress(ip, port);
+                if(::connect(socket.m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 && errno != EINPROGRESS)
+                    throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_CONNECT, std::strerror(errno));
+
+                return socket;
+            }
+
+            static Socket listen(const string_t &ip, uint16_t port, int backlog = 16)
+            {
+                Socket socket{::socket(AF_INET, SOCK_STREAM, 0)};
+                if(!socket.isValid())
+                    throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_IO, std::strerror(errno));
+
+                int flag = 1;
+                ::setsockopt(socket.m_fd, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+
+                auto address = makeAddress(ip, port);
+                if(::bind(socket.m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(socket.m_fd, backlog) != 0)
+                    throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_IO, std::strerror(errno));
+
+                socket.setNonBlocking();
+
+                return socket;
+            }
+
+            // Returns an invalid socket if there is no pending connection
+            Socket accept() const
+            {
+                Socket socket{::accept(m_fd, nullptr, nullptr)};
+                if(socket.isValid())
+                    socket.setNonBlocking();
+
+                return socket;
+            }
+
+            bool isValid() const
+            {
+                return m_fd >= 0;
+            }
+
+            int fd() const
+            {
+                return m_fd;
+            }
+
+            void close()
+            {
+                if(m_fd >= 0)
+                    ::close(std::exchange(m_fd, -1));
+            }
+
+            uint16_t localPort() const
+            {
+                sockaddr_in address{};
+                socklen_t len = sizeof(address);
+
+                if(::getsockname(m_fd, reinterpret_cast<sockaddr*>(&address), &len) != 0)
+                    throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_IO, std::strerror(errno));
+
+                return ntohs(address.sin_port);
+            }
+
+            int pendingError() const
+            {
+                int error = 0;
+                socklen_t len = sizeof(error);
+
+                if(::getsockopt(m_fd, SOL_SOCKET, SO_ERROR, &error, &len) != 0)
+                    return errno;
+
+                return error;
+            }
+
+            // Returns false on timeout
+            bool wait(short events, milliseconds_t timeout) const
+            {
+                pollfd pfd{m_fd, events, 0};
+
+                for(;;)
+                {
+                    auto result = ::poll(&pfd, 1, static_cast<int>(std::max<milliseconds_t::rep>(timeout.count(), 0)));
+
+                    if(result > 0)
+                        return true;
+
+                    if(result == 0)
+                        return false;
+
+                    if(errno != EINTR)
+                        throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_IO, std::strerror(errno));
+                }
+            }
+
+            // Returns the number of bytes sent or 0 if the call would block
+            size_t send(const char *data, size_t len) const
+            {
+                for(;;)
+                {
+                    auto result = ::send(m_fd, data, len, MSG_NOSIGNAL);
+
+                    if(result >= 0)
+                        return static_cast<size_t>(result);
+
+                    if(errno == EINTR)
+                        continue;
+
+                    if(errno == EAGAIN || errno == EWOULDBLOCK)
+                        return 0;
+
+                    if(errno == EPIPE || errno == ECONNRESET)
+                        throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_CONNECTION_CLOSED);
+
+                    throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_IO, std::strerror(errno));
+                }
+            }
+
+            // Returns the number of bytes received, 0 if the call would block or -1 if the peer closed the connection
+            std::ptrdiff_t receive(char *data, size_t len) const
+            {
+                for(;;)
+                {
+                    auto result = ::recv(m_fd, data, len, 0);
+
+                    if(result > 0)
+                    {
+#ifdef TCP_QUICKACK
+                        // Servers that write the header and the body separately would otherwise stall on delayed ACK
+                        int flag = 1;
+                        ::setsockopt(m_fd, IPPROTO_TCP, TCP_QUICKACK, &flag, sizeof(flag));
+#endif
+                        return result;
+                    }
+
+                    if(result == 0)
+                        return -1;
+
+                    if(errno == EINTR)
+                        continue;
+
+                    if(errno == EAGAIN || errno == EWOULDBLOCK)
+                        return 0;
+
+                    if(errno == ECONNRESET)
+                        return -1;
+
+                    throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_IO, std::strerror(errno));
+                }
+            }
+
+            void sendAll(std::string_view data, steady_clock_t::time_point deadline) const
+            {
+                while(!data.empty())
+                {
+                    if(auto sent = send(data.data(), data.size()); sent)
+                    {
+                        data.remove_prefix(sent);
+                        continue;
+                    }
+
+                    if(!wait(POLLOUT, remaining(deadline)))
+                        throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_TIMEOUT);
+                }
+            }
+
+            static milliseconds_t remaining(steady_clock_t::time_point deadline)
+            {
+                return std::max(std::chrono::duration_cast<milliseconds_t>(deadline - steady_clock_t::now()), milliseconds_t{0});
+            }
+
+        private:
+            explicit Socket(int fd):
+                m_fd{fd}
+            {}
+
+            void setNonBlocking() const
+            {
+                if(auto flags = ::fcntl(m_fd, F_GETFL, 0); flags < 0 || ::fcntl(m_fd, F_SETFL, flags | O_NONBLOCK) != 0)
+                    throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_IO, std::strerror(errno));
+            }
+
+            static sockaddr_in makeAddress(const string_t &ip, uint16_t port)
+            {
+                sockaddr_in address{};
+                address.sin_family = AF_INET;
+                address.sin_port   = htons(port);
+
+                if(::inet_pton(AF_INET, ip.c_str(), &address.sin_addr) != 1)
+                    throw iolink::utils::exception_argument(__func__, "Incorrect IP address (example: nnn.nnn.nnn.nnn)");
+
+                return address;
+            }
+
+        private:
+            int m_fd = -1;
+    };
+
+    /*
+     * Incremental HTTP/1.1 message parser. Data is fed as it arrives from the socket and the parser reports when a
+     * complete message is available. The internal buffer keeps its capacity between messages.
+     */
+    class HttpParser
+    {
+        public:
+            struct Message
+            {
+                int      status = 0;  // Status code of a response
+                string_t method;      // Method of a request
+                string_t target;      // Target of a request
+                string_t body;
+                bool     keep_alive = true;
+            };
+
+            // A message with a header or a body above max_size fails with ERROR_TOO_LARGE. Zero means no limit
+            explicit HttpParser(bool request = false, size_t max_size = 0):
+                m_request{request},
+                m_max_size{max_size}
+            {
+                m_buffer.reserve(4096);
+            }
+
+            void reset()
+            {
+                m_buffer.clear();
+                m_message = Message{};
+                m_state = State::HEADER;
+                m_pos = 0;
+                m_length = 0;
+            }
+
+            bool empty() const
+            {
+                return m_buffer.empty() && m_state == State::HEADER;
+            }
+
+            // Returns a buffer where up to len bytes can be received. Must be followed by commit()
+            char* prepare(size_t len)
+            {
+                m_received = m_buffer.size();
+                m_buffer.resize(m_received + len);
+                return m_buffer.data() + m_received;
+            }
+
+            // Commits the bytes received in the buffer returned by prepare(). Returns true when the message is complete
+            bool commit(size_t len)
+            {
+                m_buffer.resize(m_received + len);
+                return advance();
+            }
+
+            // Signals that the peer closed the connection. Returns true if this completes the message
+            bool finish()
+            {
+                if(m_state == State::BODY_UNTIL_CLOSE)
+                {
+                    m_message.body.assign(m_buffer, m_pos, string_t::npos);
+                    m_message.keep_alive = false;
+                    m_state = State::COMPLETE;
+                }
+
+                return m_state == State::COMPLETE;
+            }
+
+            bool isComplete() const
+            {
+                return m_state == State::COMPLETE;
+            }
+
+            Message& message()
+            {
+                return m_message;
+            }
+
+            // Drops the parsed message but keeps the bytes of the next one, if there are any
+            void next()
+            {
+                m_buffer.erase(0, m_pos);
+                m_message = Message{};
+                m_state = State::HEADER;
+                m_pos = 0;
+                m_length = 0;
+
+                if(!m_buffer.empty())
+                    advance();
+            }
+
+        private:
+            enum class State{HEADER, BODY, BODY_UNTIL_CLOSE, CHUNK_SIZE, CHUNK_DATA, CHUNK_TRAILER, COMPLETE};
+
+            bool advance()
+            {
+                for(;;)
+                {
+                    switch(m_state)
+                    {
+                        case State::HEADER:
+                        {
+                            auto end = m_buffer.find("\r\n\r\n", m_pos > 3 ? m_pos - 3 : 0);
+                            if(end == string_t::npos)
+                            {
+                                checkSize(m_buffer.size());
+                                m_pos = m_buffer.size();
+                                return false;
+                            }
+
+                            checkSize(end);
+                            parseHeader(std::string_view{m_buffer}.substr(0, end));
+                            m_pos = end + 4;
+                            break;
+                        }
+
+                        case State::BODY:
+                            if(m_buffer.size() - m_pos < m_length)
+                                return false;
+
+                            m_message.body.assign(m_buffer, m_pos, m_length);
+                            m_pos += m_length;
+                            m_state = State::COMPLETE;
+                            break;
+
+                        case State::BODY_UNTIL_CLOSE:
+                            checkSize(m_buffer.size() - m_pos);
+                            return false;
+
+                        case State::CHUNK_SIZE:
+                        {
+                            auto end = m_buffer.find("\r\n", m_pos);
+                            if(end == string_t::npos)
+                                return false;
+
+                            char *last = nullptr;
+                            m_length = std::strtoul(m_buffer.c_str() + m_pos, &last, 16);
+                            if(last == m_buffer.c_str() + m_pos)
+                                throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::BAD_RESPONSE, "Invalid chunk size");
+
+                            checkSize(m_message.body.size() + m_length);
+
+                            m_pos = end + 2;
+                            m_state = m_length ? State::CHUNK_DATA : State::CHUNK_TRAILER;
+                            break;
+                        }
+
+                        case State::CHUNK_DATA:
+                            if(m_buffer.size() - m_pos < m_length + 2)
+                                return false;
+
+                            m_message.body.append(m_buffer, m_pos, m_length);
+                            m_pos += m_length + 2;
+                            m_state = State::CHUNK_SIZE;
+                            break;
+
+                        case State::CHUNK_TRAILER:
+                        {
+                            auto end = m_buffer.find("\r\n", m_pos);
+                            if(end == string_t::npos)
+                                return false;
+
+                            // The trailer section ends with an empty line
+                            if(end == m_pos)
+                                m_state = State::COMPLETE;
+
+                            m_pos = end + 2;
+                            break;
+                        }
+
+                        case State::COMPLETE:
+                            return true;
+                    }
+                }
+            }
+
+            void parseHeader(std::string_view header)
+            {
+                auto line_end = header.find("\r\n");
+                auto start_line = header.substr(0, line_end);
+
+                auto first = start_line.find(' ');
+                if(first == std::string_view::npos)
+                    throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::BAD_RESPONSE, "Invalid start line");
+
+                auto second = start_line.find(' ', first + 1);
+                bool http10 = false;
+
+                if(m_request)
+                {
+                    m_message.method = string_t{start_line.substr(0, first)};
+                    m_message.target = string_t{start_line.substr(first + 1, second - first - 1)};
+                    http10 = (second != std::string_view::npos) && start_line.substr(second + 1) == "HTTP/1.0";
+                }
+                else
+                {
+                    m_message.status = std::atoi(string_t{start_line.substr(first + 1, 3)}.c_str());
+                    http10 = start_line.substr(0, first) == "HTTP/1.0";
+                }
+
+                m_message.keep_alive = !http10;
+
+                bool has_length = false;
+                bool chunked    = false;
+
+                while(line_end != std::string_view::npos)
+                {
+                    header.remove_prefix(line_end + 2);
+                    line_end = header.find("\r\n");
+
+                    auto line  = header.substr(0, line_end);
+                    auto colon = line.find(':');
+                    if(colon == std::string_view::npos)
+                        continue;
+
+                    auto name  = line.substr(0, colon);
+                    auto value = trim(line.substr(colon + 1));
+
+                    if(iequals(name, "content-length"))
+                    {
+                        m_length = std::strtoul(string_t{value}.c_str(), nullptr, 10);
+                        has_length = true;
+                        checkSize(m_length);
+                    }
+                    else if(iequals(name, "transfer-encoding"))
+                        chunked = icontains(value, "chunked");
+                    else if(iequals(name, "connection"))
+                    {
+                        if(icontains(value, "close"))
+                            m_message.keep_alive = false;
+                        else if(icontains(value, "keep-alive"))
+                            m_message.keep_alive = true;
+                    }
+                }
+
+                if(chunked)
+                    m_state = State::CHUNK_SIZE;
+                else if(has_length)
+                    m_state = State::BODY;
+                else if(m_request || m_message.status == 204 || m_message.status == 304 || m_message.status / 100 == 1)
+                {
+                    m_length = 0;
+                    m_state = State::BODY;
+                }
+                else
+                    m_state = State::BODY_UNTIL_CLOSE;
+            }
+
+            void checkSize(size_t size) const
+            {
+                if(m_max_size && size > m_max_size)
+                    throw iolink::utils::exception_comm(__func__, iolink::utils::exception_comm::ErrorCodeType::ERROR_TOO_LARGE, std::to_string(size) + " bytes");
+            }
+
+            static std::string_view trim(std::string_view str)
+            {
+                while(!str.empty() && (str.front() == ' ' || str.front() == '\t')) str.remove_prefix(1);
+                while(!str.empty() && (str.back() == ' ' || str.back() == '\t')) str.remove_suffix(1);
+                return str;
+            }
+
+            // std::tolower() is undefined for negative values, which a plain char holds for the bytes above 0x7F
+            static bool equalsIgnoreCase(char x, char y)
+            {
+                return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+            }
+
+            static bool iequals(std::string_view a, std::string_view b)
+            {
+                return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), equalsIgnoreCase);
+            }
+
+            static bool icontains(std::string_view str, std::string_view token)
+            {
+                return std::search(str.begin(), str.end(), token.begin(), token.end(), equalsIgnoreCase) != str.end();
+            }
+
+        private:
+            const bool   m_request;
+            const size_t m_max_size;
+            string_t     m_buffer;
+            Message      m_message;
+            State        m_state    = State::HEADER;
+            size_t       m_pos      = 0;  // Parse position inside the buffer
+            size_t       m_length   = 0;  // Length of the body or the current chunk
+            size_t       m_received = 0;
+    };
+}
+
+#endif // SOCKET_H
@@ -37,21 +37,13 @@ namespace iolink::iot
 
             json_t getDataMulti(std::vector<string_t> element_urls, bool consistent = false) const
             {
-                // Erase all empty urls
-                element_urls.erase(remove_if(element_urls.begin(),
-                                             element_urls.end(),
-                                             [](const string_t &el){return el.empty();}),
-                                   element_urls.end()
-                                   );
-
-                if(element_urls.empty()) return json_t{};
-
-                json_t data;
-                data["datatosend"] = element_urls;
-                data["consistent"] = consistent;
+                return requestDataMulti(std::move(element_urls), consistent);
+            }
 
-                return requestPost("/getdatamulti", data);
-            };
+            void getDataMultiAsync(std::vector<string_t> element_urls, bool consistent, callback_t<json_t> callback) const
+            {
+                requestDataMultiAsync(std::move(element_urls), consistent, std::move(callback));
+            }
 
             json_t getElementInfo(const string_t &url) const{return requestPost("/getelementinfo", R"("url":")"+url+R"(")");}
             json_t setElementInfo(const string_t &url, const string_t &uid, std::vector<string_t> profiles) const; // FIXME: complete implementation of setElementInfo
@@ -0,0 +1,165 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include "inc.h"
+#include "exception.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace iolink::utils
+{
+    /*
+     * Memory mapping of a whole file. The pages are loaded on demand while the file is read. A file created with
+     * create() is mapped for writing and the changes are written back to the file.
+     */
+    class MappedFile
+    {
+        public:
+            // Maps an existing file read only
+            explicit MappedFile(const string_t &path):
+                MappedFile{path, 0, false}
+            {}
+
+            // Creates or truncates the file to the size and maps it for writing
+            static MappedFile create(const string_t &path, size_t size)
+            {
+                return MappedFile{path, size, true};
+            }
+
+            MappedFile(const MappedFile&) =delete;
+            MappedFile& operator= (const MappedFile&) =delete;
+
+            MappedFile(MappedFile&& other) noexcept:
+                m_data{std::exchange(other.m_data, nullptr)},
+                m_size{std::exchange(other.m_size, 0)},
+                m_writable{other.m_writable}
+            {}
+
+            MappedFile& operator= (MappedFile&& other) noexcept
+            {
+                if(this != &other)
+                {
+                    unmap();
+                    m_data     = std::exchange(other.m_data, nullptr);
+                    m_size     = std::exchange(other.m_size, 0);
+                    m_writable = other.m_writable;
+                }
+
+                return *this;
+            }
+
+            ~MappedFile()
+            {
+                unmap();
+            }
+
+            const uint8_t* data() const
+            {
+                return m_data;
+            }
+
+            // Throws if the file is mapped read only
+            uint8_t* writableData()
+            {
+                if(!m_writable)
+                    throw iolink::utils::exception_logic(__func__, "File is mapped read only");
+
+                return m_data;
+            }
+
+            size_t size() const
+            {
+                return m_size;
+            }
+
+            bool isWritable() const
+            {
+                return m_writable;
+            }
+
+        private:
+            MappedFile(const string_t &path, size_t size, bool writable):
+                m_writable{writable}
+            {
+                const int fd = writable ? ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) : ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                if(fd < 0)
+                    throw iolink::utils::exception_argument(__func__, "Can't open " + path + ": " + std::strerror(errno));
+
+                auto fail = [fd, &path](const char *action)
+                {
+                    const int error = errno;
+                    ::close(fd);
+                    throw iolink::utils::exception_argument(__func__, "Can't " + string_t(action) + " " + path + ": " + std::strerror(error));
+                };
+
+                if(writable)
+                {
+                    if(::ftruncate(fd, static_cast<off_t>(size)) != 0)
+                        fail("resize");
+
+                    m_size = size;
+                }
+                else
+                {
+                    struct stat info;
+                    if(::fstat(fd, &info) != 0)
+                        fail("stat");
+
+                    m_size = static_cast<size_t>(info.st_size);
+                }
+
+                if(m_size)
+                {
+                    void *data = ::mmap(nullptr, m_size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+
+                    if(data == MAP_FAILED)
+                        fail("map");
+
+                    // The file is accessed front to back
+                    ::madvise(data, m_size, MADV_SEQUENTIAL);
+                    m_data = static_cast<uint8_t*>(data);
+                }
+
+                ::close(fd);
+            }
+
+            void unmap() noexcept
+            {
+                if(m_data)
+                    ::munmap(m_data, m_size);
+            }
+
+        private:
+            uint8_t* m_data     = nullptr;
+            size_t   m_size     = 0;
+            bool     m_writable = false;
+    };
+}
+
+#endif // MAPPEDFILE_H
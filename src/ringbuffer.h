@@ -0,0 +1,204 @@
+/*
+ *   ___ ___        _     _       _
+ *  |_ _/ _ \      | |   (_)_ __ | | __
+ *   | | | | |_____| |   | | '_ \| |/ /
+ *   | | |_| |_____| |___| | | | |   <
+ *  |___\___/      |_____|_|_| |_|_|\_\
+ *
+ * Header only driver library for interfacing IO-Link devices and masters
+ * written in modern C++
+ *
+ * Version: 0.1.0
+ * URL: https://github.com/ekondayan/libiolink.git
+ *
+ * Copyright (c) 2019 Emil Kondayan
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace iolink::utils
+{
+    /*
+     * Lock-free ring buffer with a single producer and any number of consumers. The producer never waits for the
+     * consumers and overwrites the oldest value when the ring is full. Every slot is protected by a sequence lock, so a
+     * consumer that races with the producer detects the torn copy and reports the value as lost instead of returning
+     * it.
+     *
+     * Example:
+     *
+     *     iolink::utils::RingBuffer<iolink::master::al1352::ProcessDataSnapshot, 1024> ring;
+     *
+     *     // Acquisition thread
+     *     ring.push(al1352.iolinkmaster.snapshotProcessData());
+     *
+     *     // Any consumer thread
+     *     ProcessDataSnapshot latest;
+     *     if(ring.latest(latest)) ...
+     *
+     *     uint64_t cursor = 0;
+     *     while(ring.next(cursor, latest)) ...     // Every value exactly once, unless the producer laps the consumer
+     *
+     * The values are copied in and out, so T must be trivially copyable.
+     */
+    template<typename T, size_t Capacity>
+    class RingBuffer
+    {
+            static_assert(std::is_trivially_copyable_v<T>, "RingBuffer requires a trivially copyable type");
+            static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+        public:
+            RingBuffer() =default;
+            RingBuffer(const RingBuffer&) =delete;
+            RingBuffer& operator= (const RingBuffer&) =delete;
+
+            static constexpr size_t capacity()
+            {
+                return Capacity;
+            }
+
+            // Must be called from a single thread
+            void push(const T &value) noexcept
+            {
+                const uint64_t sequence = m_head.load(std::memory_order_relaxed);
+                Slot &slot = m_slots[sequence & (Capacity - 1)];
+
+                // Odd version while the slot is written
+                slot.version.store(2 * sequence + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+
+                store(slot, value);
+
+                slot.version.store(2 * sequence + 2, std::memory_order_release);
+                m_head.store(sequence + 1, std::memory_order_release);
+            }
+
+            // Number of values pushed so far. The sequence number of the next value
+            uint64_t head() const noexcept
+            {
+                return m_head.load(std::memory_order_acquire);
+            }
+
+            // Sequence number of the oldest value that is still in the ring
+            uint64_t tail() const noexcept
+            {
+                const uint64_t head = this->head();
+                return head > Capacity ? head - Capacity : 0;
+            }
+
+            // Returns false if the value is not pushed yet, was overwritten, or was overwritten during the copy
+            bool read(uint64_t sequence, T &value) const noexcept
+            {
+                const Slot &slot = m_slots[sequence & (Capacity - 1)];
+
+                const uint64_t version = slot.version.load(std::memory_order_acquire);
+                if(version != 2 * sequence + 2)
+                    return false;
+
+                load(slot, value);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return slot.version.load(std::memory_order_relaxed) == version;
+            }
+
+            // Returns false if nothing was pushed yet
+            bool latest(T &value) const noexcept
+            {
+                for(;;)
+                {
+                    const uint64_t head = this->head();
+
+                    if(head == 0)
+                        return false;
+
+                    if(read(head - 1, value))
+                        return true;
+                }
+            }
+
+            /*
+             * Reads the value at the cursor and advances it. A cursor that fell behind the ring jumps to the oldest
+             * value that is still available. Returns false if there is no new value.
+             */
+            bool next(uint64_t &cursor, T &value) const noexcept
+            {
+                for(;;)
+                {
+                    if(cursor >= head())
+                        return false;
+
+                    cursor = std::max(cursor, tail());
+
+                    if(read(cursor, value))
+                    {
+                        ++cursor;
+                        return true;
+                    }
+                }
+            }
+
+            /*
+             * Copies up to count of the latest values, oldest first. Returns the number of copied values, which is
+             * smaller than count if the ring holds fewer values or the producer overwrote some of them.
+             */
+            size_t history(T *values, size_t count) const noexcept
+            {
+                const uint64_t head  = this->head();
+                const uint64_t first = head - std::min<uint64_t>({count, head, Capacity});
+
+                size_t copied = 0;
+
+                for(uint64_t sequence = first; sequence < head; ++sequence)
+                    if(read(sequence, values[copied]))
+                        ++copied;
+
+                return copied;
+            }
+
+        private:
+            static constexpr size_t words = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+            // The value is stored as atomic words, so a torn read is detected instead of being a data race
+            struct alignas(64) Slot
+            {
+                std::atomic<uint64_t>                      version{0};
+                std::array<std::atomic<uint64_t>, words>   data{};
+            };
+
+            static void store(Slot &slot, const T &value) noexcept
+            {
+                std::array<uint64_t, words> buffer{};
+                std::memcpy(buffer.data(), &value, sizeof(T));
+
+                for(size_t i = 0; i < words; ++i)
+                    slot.data[i].store(buffer[i], std::memory_order_relaxed);
+            }
+
+            static void load(const Slot &slot, T &value) noexcept
+            {
+                std::array<uint64_t, words> buffer;
+
+                for(size_t i = 0; i < words; ++i)
+                    buffer[i] = slot.data[i].load(std::memory_order_relaxed);
+
+                std::memcpy(&value, buffer.data(), sizeof(T));
+            }
+
+        private:
+            std::array<Slot, Capacity>       m_slots;
+            alignas(64) std::atomic<uint64_t> m_head{0};
+    };
+}
+
+#endif // RINGBUFFER_H
@@ -24,6 +24,14 @@
 #include "inc.h"
 #include "exception.h"
 
+#include <array>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IOLINK_HEX_SSE2 1
+#endif
+
 namespace iolink::utils
 {
     template <typename Type, std::size_t bits, std::size_t lshift = 0>
@@ -52,23 +60,138 @@ namespace iolink::utils
         return *((char*)&num_endianness) == 0x01;
     }
 
+    namespace detail
+    {
+        // Value of every hex digit, 0xFF for the chars that are not hex digits
+        constexpr std::array<uint8_t, 256> makeHexDecodeLut()
+        {
+            std::array<uint8_t, 256> lut{};
+
+            for(size_t i = 0; i < lut.size(); ++i)
+                lut[i] = 0xFF;
+
+            for(uint8_t i = 0; i < 10; ++i)
+                lut['0' + i] = i;
+
+            for(uint8_t i = 0; i < 6; ++i)
+            {
+                lut['A' + i] = 10 + i;
+                lut['a' + i] = 10 + i;
+            }
+
+            return lut;
+        }
+
+        inline constexpr std::array<uint8_t, 256> hex_decode_lut = makeHexDecodeLut();
+        inline constexpr char                     hex_encode_lut[] = "0123456789ABCDEF";
+
+#ifdef IOLINK_HEX_SSE2
+        // Decodes 16 hex chars into 8 bytes. Returns false if any of the chars is not a hex digit
+        inline bool hexDecode16(const char *str, uint8_t *output) noexcept
+        {
+            const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+
+            // The chars above 0x7F are negative, so they fail both range checks
+            const __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+            const __m128i lower    = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+            const __m128i is_alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+
+            if(_mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) != 0xFFFF)
+                return false;
+
+            const __m128i nibbles = _mm_or_si128(_mm_and_si128(is_digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+                                                 _mm_and_si128(is_alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+
+            // The even chars are the high nibbles and land in the low byte of every 16 bit lane
+            const __m128i high  = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4);
+            const __m128i low   = _mm_srli_epi16(nibbles, 8);
+            const __m128i bytes = _mm_packus_epi16(_mm_or_si128(high, low), _mm_setzero_si128());
+
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(output), bytes);
+
+            return true;
+        }
+
+        // Encodes 16 bytes into 32 upper case hex chars
+        inline void hexEncode16(const uint8_t *data, char *output) noexcept
+        {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            const __m128i mask  = _mm_set1_epi8(0x0F);
+            const __m128i high  = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+            const __m128i low   = _mm_and_si128(bytes, mask);
+
+            auto toChars = [](__m128i nibbles)
+            {
+                const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('A' - '0' - 10));
+                return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+            };
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output),      toChars(_mm_unpacklo_epi8(high, low)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16), toChars(_mm_unpackhi_epi8(high, low)));
+        }
+#endif
+    }
+
+    /*
+     * Decodes "length" hex chars into length / 2 bytes of the output buffer. Both upper and lower case digits are
+     * accepted. Returns false if the length is odd or the string contains a char that is not a hex digit, in which case
+     * the content of the output is unspecified.
+     */
+    inline bool hexDecode(const char *str, size_t length, uint8_t *output) noexcept
+    {
+        if(length & 1)
+            return false;
+
+        size_t i = 0;
+
+#ifdef IOLINK_HEX_SSE2
+        for(; i + 16 <= length; i += 16)
+            if(!detail::hexDecode16(str + i, output + i / 2))
+                return false;
+#endif
+
+        for(; i < length; i += 2)
+        {
+            const uint8_t high = detail::hex_decode_lut[static_cast<uint8_t>(str[i])];
+            const uint8_t low  = detail::hex_decode_lut[static_cast<uint8_t>(str[i + 1])];
+
+            if((high | low) & 0xF0)
+                return false;
+
+            output[i / 2] = static_cast<uint8_t>(high << 4 | low);
+        }
+
+        return true;
+    }
+
+    // Encodes "length" bytes into 2 * length upper case hex chars of the output buffer. The output is not terminated
+    inline void hexEncode(const uint8_t *data, size_t length, char *output) noexcept
+    {
+        size_t i = 0;
+
+#ifdef IOLINK_HEX_SSE2
+        for(; i + 16 <= length; i += 16)
+            detail::hexEncode16(data + i, output + 2 * i);
+#endif
+
+        for(; i < length; ++i)
+        {
+            output[2 * i]     = detail::hex_encode_lut[data[i] >> 4];
+            output[2 * i + 1] = detail::hex_encode_lut[data[i] & 0x0F];
+        }
+    }
+
     template <typename T>
     inline T hexDecode(const string_t &str)
     {
         auto hexCharToInt = [](const char ch) -> uint8_t
         {
-            static const char* const lut_upper = "0123456789ABCDEF";
-            static const char* const lut_lower = "0123456789abcdef";
-
-            const char* p = std::lower_bound(lut_lower, lut_lower + 16, ch);
-            if (*p == ch)
-                return uint8_t(p - lut_lower);
+            const uint8_t value = detail::hex_decode_lut[static_cast<uint8_t>(ch)];
 
-            p = std::lower_bound(lut_upper, lut_upper + 16, ch);
-            if(*p == ch)
-                return uint8_t(p - lut_upper);
+            if(value > 0x0F)
+                throw iolink::utils::exception_argument(__func__, "Input string contains a char that is not a hex digit");
 
-            throw iolink::utils::exception_argument(__func__, "Input string contains a char that is not a hex digit");
+            return value;
         };
 
         if constexpr(std::is_same_v<T, bool>)
@@ -88,23 +211,10 @@ namespace iolink::utils
             if (str.length() != 8)
                 throw iolink::utils::exception_argument(__func__, "Input string must be 8 bytes long");
 
-            float    decoded = 0;
-            uint32_t *decoded_ptr = reinterpret_cast<uint32_t*>(&decoded);
-
-            if(isLittleEndian())
-                for (int i = 7; i >= 1; i -= 2)
-                {
-                    *decoded_ptr |= (hexCharToInt(str[i - 1]) << 4) | hexCharToInt(str[i]);
-                    if(i > 1)
-                        *decoded_ptr <<= 8;
-                }
-            else
-                for (int i = 0; i < 8; i += 2)
-                {
-                    *decoded_ptr |= (hexCharToInt(str[i]) << 4) | hexCharToInt(str[i + 1]);
-                    if( i < 6 )
-                        *decoded_ptr <<= 8;
-                }
+            // The bits of the big endian IEEE 754 single precision number
+            const auto bits = hexDecode<uint32_t>(str);
+            float decoded = 0;
+            std::memcpy(&decoded, &bits, sizeof(decoded));
 
             return decoded;
         }
@@ -116,24 +226,14 @@ namespace iolink::utils
             if(sizeof(T) * 2 != len)
                 throw iolink::utils::exception_argument(__func__, "Input string does not corespond with the integer length");
 
-            T output = 0;
+            // The string is big endian. The shifts do not depend on the byte order of the host
+            using unsigned_t = std::make_unsigned_t<T>;
+            unsigned_t output = 0;
 
-            if(isLittleEndian())
-                for (size_t i = 0; i < len; i += 2)
-                {
-                    output |= (hexCharToInt(str[i]) << 4) | hexCharToInt(str[i + 1]);
-                    if( (i+2) < len )
-                        output <<= 8;
-                }
-            else
-                for (size_t i = len; i >= 2; i += 2)
-                {
-                    output |= (hexCharToInt(str[i - 1]) << 4) | hexCharToInt(str[i]);
-                    if( (i+2) > 2 )
-                        output <<= 8;
-                }
+            for (size_t i = 0; i < len; ++i)
+                output = static_cast<unsigned_t>((output << 4) | hexCharToInt(str[i]));
 
-            return output;
+            return static_cast<T>(output);
         }
         else if constexpr(std::is_same_v<T, string_t> || std::is_same_v<T, vector_t>)
         {
@@ -141,11 +241,10 @@ namespace iolink::utils
             if (len & 1)
                 throw iolink::utils::exception_argument(__func__, "Input string has odd length");
 
-            T output;
-            output.reserve(len / 2);
+            T output(len / 2, 0);
 
-            for (size_t i = 0; i < len; i += 2)
-                output.push_back((hexCharToInt(str[i]) << 4) | hexCharToInt(str[i + 1]));
+            if(!hexDecode(str.data(), len, reinterpret_cast<uint8_t*>(output.data())))
+                throw iolink::utils::exception_argument(__func__, "Input string contains a char that is not a hex digit");
 
             return output;
         }
@@ -163,30 +262,15 @@ namespace iolink::utils
 
         if constexpr(std::is_same_v<T, bool>)
         {
-            return "0" + lut_upper[value & 0x0F];
+            return string_t{'0', lut_upper[value & 0x0F]};
         }
         else if constexpr(std::is_floating_point_v<T>)
         {
-            float f = static_cast<float>(value);
-            uint8_t *ch = reinterpret_cast<uint8_t*>(&f);
-            string_t output;
+            const float f = static_cast<float>(value);
+            uint32_t bits = 0;
+            std::memcpy(&bits, &f, sizeof(bits));
 
-            output.reserve(8);
-
-            if(isLittleEndian())
-                for(int i = 0; i < 4; ++i)
-                {
-                    output.push_back(lut_upper[ch[i] >> 4]);
-                    output.push_back(lut_upper[ch[i] & 0x0F]);
-                }
-            else
-                for(int i = 3; i >= 0; --i)
-                {
-                    output.push_back(lut_upper[ch[i] >> 4]);
-                    output.push_back(lut_upper[ch[i] & 0x0F]);
-                }
-
-            return output;
+            return hexEncode(bits);
         }
         else if constexpr(std::is_integral_v<T>)
         {
@@ -194,34 +278,19 @@ namespace iolink::utils
 
             output.reserve(2 * sizeof(T));
 
-            if(isLittleEndian())
-                for(int i = sizeof(T) * 8 - 4; i >= 0; i -= 4)
-                {
-                    const uint8_t ch = (value >> i) & 0x0F;
-                    output.push_back(lut_upper[ch]);
-                }
-            else
-                for(int i = 0; i < int(sizeof(T) * 8 - 4); i += 4)
-                {
-                    const uint8_t ch = (value >> i) & 0x0F;
-                    output.push_back(lut_upper[ch]);
-                }
+            // Most significant nibble first. The shifts do not depend on the byte order of the host
+            for(int i = sizeof(T) * 8 - 4; i >= 0; i -= 4)
+            {
+                const uint8_t ch = (value >> i) & 0x0F;
+                output.push_back(lut_upper[ch]);
+            }
 
             return output;
         }
         else if constexpr(std::is_same_v<T, string_t>|| std::is_same_v<T, vector_t>)
         {
-            const size_t len = value.length();
-            string_t output;
-
-            output.reserve(2 * len);
-
-            for(size_t i = 0; i < len; ++i)
-            {
-                const uint8_t c = value[i];
-                output.push_back(lut_upper[c >> 4]);
-                output.push_back(lut_upper[c & 0x0F]);
-            }
+            string_t output(2 * value.size(), '0');
+            hexEncode(reinterpret_cast<const uint8_t*>(value.data()), value.size(), output.data());
 
             return output;
         }
@@ -232,108 +301,254 @@ namespace iolink::utils
     }
 
 
-    inline string_t base64Encode(const vector_t& input)
+    namespace detail
+    {
+        inline constexpr char base64_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        // Two base64 chars for every 12 bit value, so three bytes are encoded with two lookups
+        constexpr std::array<std::array<char, 2>, 4096> makeBase64EncodeLut()
+        {
+            std::array<std::array<char, 2>, 4096> lut{};
+
+            for(size_t i = 0; i < lut.size(); ++i)
+                lut[i] = {base64_alphabet[i >> 6], base64_alphabet[i & 0x3F]};
+
+            return lut;
+        }
+
+        // Value of every base64 char, 0xFF for the chars that are not part of the alphabet
+        constexpr std::array<uint8_t, 256> makeBase64DecodeLut()
+        {
+            std::array<uint8_t, 256> lut{};
+
+            for(size_t i = 0; i < lut.size(); ++i)
+                lut[i] = 0xFF;
+
+            for(uint8_t i = 0; i < 64; ++i)
+                lut[static_cast<uint8_t>(base64_alphabet[i])] = i;
+
+            return lut;
+        }
+
+        inline constexpr std::array<std::array<char, 2>, 4096> base64_encode_lut = makeBase64EncodeLut();
+        inline constexpr std::array<uint8_t, 256>               base64_decode_lut = makeBase64DecodeLut();
+    }
+
+    constexpr size_t base64EncodedLength(size_t length)
     {
-        static const char* const lut_base64 = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-        constexpr char pad_char_base64 = '=';
+        return (length + 2) / 3 * 4;
+    }
 
-        string_t output;
-        output.reserve(((input.size() / 3) + (input.size() % 3 > 0)) * 4);
+    // Upper bound of the decoded length. The exact length is returned by base64Decode()
+    constexpr size_t base64DecodedLength(size_t length)
+    {
+        return length / 4 * 3;
+    }
 
-        uint32_t tmp;
-        auto it = input.begin();
+    // Encodes "length" bytes into base64EncodedLength(length) chars of the output buffer. The output is not terminated
+    inline void base64Encode(const uint8_t *data, size_t length, char *output) noexcept
+    {
+        const size_t blocks = length / 3;
 
-        for(size_t i = 0; i < input.size() / 3; ++i)
+        for(size_t i = 0; i < blocks; ++i, data += 3, output += 4)
         {
-            tmp  = (*it++) << 16 | (*it++) << 8 | (*it++);
+            const uint32_t value = uint32_t(data[0]) << 16 | uint32_t(data[1]) << 8 | data[2];
 
-            output.append(1, lut_base64[(tmp >> 18) & 0x0000003F]);
-            output.append(1, lut_base64[(tmp >> 12) & 0x0000003F]);
-            output.append(1, lut_base64[(tmp >> 6)  & 0x0000003F]);
-            output.append(1, lut_base64[ tmp        & 0x0000003F]);
+            std::memcpy(output,     detail::base64_encode_lut[value >> 12].data(),   2);
+            std::memcpy(output + 2, detail::base64_encode_lut[value & 0xFFF].data(), 2);
         }
 
-        switch(input.size() % 3)
+        switch(length % 3)
         {
             case 1:
-                tmp = (*it++) << 16;
-                output.append(1, lut_base64[(tmp >> 18) & 0x0000003F]);
-                output.append(1, lut_base64[(tmp >> 12) & 0x0000003F]);
-                output.append(2, pad_char_base64);
+                output[0] = detail::base64_alphabet[data[0] >> 2];
+                output[1] = detail::base64_alphabet[(data[0] & 0x03) << 4];
+                output[2] = '=';
+                output[3] = '=';
                 break;
             case 2:
-                tmp  = (*it++) << 16 | (*it++) << 8;
-                output.append(1, lut_base64[(tmp >> 18) & 0x0000003F]);
-                output.append(1, lut_base64[(tmp >> 12) & 0x0000003F]);
-                output.append(1, lut_base64[(tmp >> 6)  & 0x0000003F]);
-                output.append(1, pad_char_base64);
+                output[0] = detail::base64_alphabet[data[0] >> 2];
+                output[1] = detail::base64_alphabet[(data[0] & 0x03) << 4 | data[1] >> 4];
+                output[2] = detail::base64_alphabet[(data[1] & 0x0F) << 2];
+                output[3] = '=';
                 break;
         }
+    }
+
+    /*
+     * Decodes "length" base64 chars into the output buffer, which must hold base64DecodedLength(length) bytes. The
+     * input must be padded. Returns the number of decoded bytes, or SIZE_MAX if the input is not valid base64, in which
+     * case the content of the output is unspecified.
+     */
+    inline size_t base64Decode(const char *str, size_t length, uint8_t *output) noexcept
+    {
+        if(length % 4)
+            return SIZE_MAX;
+
+        if(length == 0)
+            return 0;
+
+        const auto &lut = detail::base64_decode_lut;
+        const uint8_t *input = reinterpret_cast<const uint8_t*>(str);
+        const size_t blocks = length / 4 - 1;
+
+        // The invalid chars have the highest bit set, so one check covers the whole block
+        for(size_t i = 0; i < blocks; ++i, input += 4, output += 3)
+        {
+            const uint32_t a = lut[input[0]], b = lut[input[1]], c = lut[input[2]], d = lut[input[3]];
+
+            if((a | b | c | d) & 0x80)
+                return SIZE_MAX;
+
+            const uint32_t value = a << 18 | b << 12 | c << 6 | d;
+
+            output[0] = static_cast<uint8_t>(value >> 16);
+            output[1] = static_cast<uint8_t>(value >> 8);
+            output[2] = static_cast<uint8_t>(value);
+        }
+
+        // The last block may be padded
+        const size_t padding = (input[3] == '=') + (input[2] == '=' && input[3] == '=');
+        const uint32_t a = lut[input[0]], b = lut[input[1]];
+        const uint32_t c = padding > 1 ? 0 : lut[input[2]];
+        const uint32_t d = padding > 0 ? 0 : lut[input[3]];
+
+        if((a | b | c | d) & 0x80)
+            return SIZE_MAX;
+
+        const uint32_t value = a << 18 | b << 12 | c << 6 | d;
+
+        output[0] = static_cast<uint8_t>(value >> 16);
+        if(padding < 2)
+            output[1] = static_cast<uint8_t>(value >> 8);
+        if(padding < 1)
+            output[2] = static_cast<uint8_t>(value);
+
+        return blocks * 3 + 3 - padding;
+    }
+
+    inline string_t base64Encode(const vector_t& input)
+    {
+        string_t output(base64EncodedLength(input.size()), '=');
+        base64Encode(input.data(), input.size(), output.data());
 
         return output;
     }
 
     inline string_t base64Encode(const string_t& input)
     {
-        return base64Encode(vector_t{input.begin(), input.end()});
+        string_t output(base64EncodedLength(input.size()), '=');
+        base64Encode(reinterpret_cast<const uint8_t*>(input.data()), input.size(), output.data());
+
+        return output;
     }
 
-    //    std::vector<byte> base64Decode(const std::string& input)
-    //            {
-    //                    if(input.length() % 4)
-    //                            throw std::runtime_error("Invalid base64 length!");
-
-    //                    std::size_t padding{};
-
-    //                    if(input.length())
-    //                    {
-    //                            if(input[input.length() - 1] == kPadCharacter) padding++;
-    //                            if(input[input.length() - 2] == kPadCharacter) padding++;
-    //                    }
-
-    //                    std::vector<byte> decoded;
-    //                    decoded.reserve(((input.length() / 4) * 3) - padding);
-
-    //                    std::uint32_t temp{};
-    //                    auto it = input.begin();
-
-    //                    while(it < input.end())
-    //                    {
-    //                            for(std::size_t i = 0; i < 4; ++i)
-    //                            {
-    //                                    temp <<= 6;
-    //                                    if     (*it >= 0x41 && *it <= 0x5A) temp |= *it - 0x41;
-    //                                    else if(*it >= 0x61 && *it <= 0x7A) temp |= *it - 0x47;
-    //                                    else if(*it >= 0x30 && *it <= 0x39) temp |= *it + 0x04;
-    //                                    else if(*it == 0x2B)                temp |= 0x3E;
-    //                                    else if(*it == 0x2F)                temp |= 0x3F;
-    //                                    else if(*it == kPadCharacter)
-    //                                    {
-    //                                            switch(input.end() - it)
-    //                                            {
-    //                                            case 1:
-    //                                                    decoded.push_back((temp >> 16) & 0x000000FF);
-    //                                                    decoded.push_back((temp >> 8 ) & 0x000000FF);
-    //                                                    return decoded;
-    //                                            case 2:
-    //                                                    decoded.push_back((temp >> 10) & 0x000000FF);
-    //                                                    return decoded;
-    //                                            default:
-    //                                                    throw std::runtime_error("Invalid padding in base64!");
-    //                                            }
-    //                                    }
-    //                                    else throw std::runtime_error("Invalid character in base64!");
-
-    //                                    ++it;
-    //                            }
-
-    //                            decoded.push_back((temp >> 16) & 0x000000FF);
-    //                            decoded.push_back((temp >> 8 ) & 0x000000FF);
-    //                            decoded.push_back((temp      ) & 0x000000FF);
-    //                    }
-
-    //                    return decoded;
-    //            }
+    inline vector_t base64Decode(const string_t& input)
+    {
+        vector_t output(base64DecodedLength(input.size()));
+
+        const size_t length = base64Decode(input.data(), input.size(), output.data());
+        if(length == SIZE_MAX)
+            throw iolink::utils::exception_argument(__func__, "Input string is not valid base64");
+
+        output.resize(length);
+
+        return output;
+    }
+
+    /*
+     * Encodes a stream of data chunk by chunk, so a large image does not have to be held in memory together with its
+     * encoded copy. The chunks may have any size, the encoder keeps the bytes that do not fill a block of three.
+     *
+     * Example:
+     *
+     *     iolink::utils::Base64Encoder encoder;
+     *     string_t encoded;
+     *
+     *     while(auto read = file.read(buffer, sizeof(buffer)))
+     *     {
+     *         encoded.clear();
+     *         encoder.update(buffer, read, encoded);
+     *         send(encoded);
+     *     }
+     *
+     *     encoded.clear();
+     *     encoder.finish(encoded);
+     *     send(encoded);
+     */
+    class Base64Encoder
+    {
+        public:
+            // Appends the encoded chars to the output
+            void update(const uint8_t *data, size_t length, string_t &output)
+            {
+                // Complete the block left from the previous chunk
+                while(m_pending_length && m_pending_length < 3 && length)
+                {
+                    m_pending[m_pending_length++] = *data++;
+                    --length;
+                }
+
+                if(m_pending_length == 3)
+                {
+                    append(m_pending.data(), 3, output);
+                    m_pending_length = 0;
+                }
+
+                const size_t whole = length / 3 * 3;
+                append(data, whole, output);
+
+                for(size_t i = whole; i < length; ++i)
+                    m_pending[m_pending_length++] = data[i];
+            }
+
+            // Appends the last, padded block. The encoder can be reused afterwards
+            void finish(string_t &output)
+            {
+                append(m_pending.data(), m_pending_length, output);
+                m_pending_length = 0;
+            }
+
+        private:
+            static void append(const uint8_t *data, size_t length, string_t &output)
+            {
+                if(length == 0)
+                    return;
+
+                const size_t offset = output.size();
+                output.resize(offset + base64EncodedLength(length));
+                base64Encode(data, length, output.data() + offset);
+            }
+
+        private:
+            std::array<uint8_t, 3> m_pending{};
+            size_t                 m_pending_length = 0;
+    };
+
+    // Creates a completion handler that fulfills the returned future
+    template<typename T>
+    std::pair<std::future<T>, callback_t<T>> makeFutureCallback()
+    {
+        auto promise = std::make_shared<std::promise<T>>();
+        auto future  = promise->get_future();
+
+        if constexpr(std::is_void_v<T>)
+            return {std::move(future), [promise](std::exception_ptr error)
+                    {
+                        if(error)
+                            promise->set_exception(error);
+                        else
+                            promise->set_value();
+                    }};
+        else
+            return {std::move(future), [promise](T value, std::exception_ptr error)
+                    {
+                        if(error)
+                            promise->set_exception(error);
+                        else
+                            promise->set_value(std::move(value));
+                    }};
+    }
 
     constexpr auto operator "" _ui64(unsigned long long int integer)
     {